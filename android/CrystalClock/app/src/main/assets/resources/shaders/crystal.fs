@@ -0,0 +1,151 @@
+// Crystal prisms. Variant defines: NR_POINT_LIGHTS, NORMAL_MAP, RIM_LIGHT
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+varying vec3 fragPosition;
+varying vec3 fragNormal;
+
+// std140 layout, scalars fill the last component of the preceding vec3
+struct Material {
+    vec3  ambient;
+    float shininess;
+    vec3  diffuse;
+    vec3  specular;
+};
+
+struct DirLight {
+    vec3 direction;
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+};
+
+struct PointLight {
+    vec3  position;
+    float constant;
+    vec3  ambient;
+    float linear;
+    vec3  diffuse;
+    float quadratic;
+    vec3  specular;
+};
+
+#if GLSL_VERSION == 330
+layout(std140) uniform Lighting {
+    Material material;
+    DirLight dirLight;
+    PointLight pointLights[NR_POINT_LIGHTS];
+};
+#else
+// Material (3), DirLight (4) and 4 vectors per PointLight, same memory as the GLSL 330 block
+#define LIGHTING_VECTORS (7 + 4 * NR_POINT_LIGHTS)
+uniform vec4 lighting[LIGHTING_VECTORS];
+
+Material material;
+DirLight dirLight;
+#endif
+
+uniform sampler2D normalMap;
+uniform vec3 viewPos;
+
+vec3 CalcRimLight(vec3 viewDir, vec3 N)
+{
+	return vec3(1.0) * smoothstep(0.3, 0.4, pow(max(0.0, 1.0 - dot(viewDir, N)), 2.0));
+}
+
+vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir)
+{
+	vec3 lightDir = normalize(-light.direction);
+	// diffuse
+	float diff = max(dot(normal, lightDir), 0.0);
+
+	// specular
+	vec3 reflectDir = reflect(-lightDir, normal);
+	float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+	
+	// combine results
+    vec3 ambient  = light.ambient  * material.ambient;
+    vec3 diffuse  = light.diffuse  * diff * material.diffuse;
+    vec3 specular = light.specular * spec * material.specular;
+    return (ambient + diffuse + specular);
+}
+
+vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPosition, vec3 viewDir)
+{
+    vec3 lightDir = normalize(light.position - fragPosition);
+    // diffuse shading
+    float diff = max(dot(normal, lightDir), 0.0);
+    // specular shading
+    vec3 reflectDir = reflect(-lightDir, normal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    // attenuation
+    float distance    = length(light.position - fragPosition);
+    float attenuation = 1.0 / (light.constant + light.linear * distance + 
+  			     light.quadratic * (distance * distance));    
+				 
+    vec3 ambient  = light.ambient  * material.ambient;
+    vec3 diffuse  = light.diffuse  * diff * material.diffuse;
+    vec3 specular = light.specular * spec * material.specular;
+	
+    ambient  *= attenuation;
+    diffuse  *= attenuation;
+    specular *= attenuation;
+	
+    return (ambient + diffuse + specular);
+}
+
+void main()
+{
+#if GLSL_VERSION == 100
+	material.ambient   = lighting[0].xyz;
+	material.shininess = lighting[0].w;
+	material.diffuse   = lighting[1].xyz;
+	material.specular  = lighting[2].xyz;
+
+	dirLight.direction = lighting[3].xyz;
+	dirLight.ambient   = lighting[4].xyz;
+	dirLight.diffuse   = lighting[5].xyz;
+	dirLight.specular  = lighting[6].xyz;
+#endif
+
+#if NORMAL_MAP
+	// Lighting used to run in tangent space, with the light, view and fragment positions
+	// multiplied by TBN in every fragment. TBN is orthonormal, so it cancels out of every
+	// dot product and distance below, and the same result needs no matrix products at all.
+	#if GLSL_VERSION == 100
+    vec3 norm = texture2D(normalMap, fract(fragTexCoord)).rgb;
+	#else
+    vec3 norm = texture2D(normalMap, fragTexCoord).rgb;
+	#endif
+	norm = normalize(norm * 2.0 - 1.0);
+#else
+    vec3 norm = fragNormal;
+#endif
+
+    vec3 viewDir = normalize(viewPos - fragPosition);
+    vec3 result  = CalcDirLight(dirLight, fragNormal, viewDir);
+	
+    for(int i = 0; i < NR_POINT_LIGHTS; i++)
+	{
+#if GLSL_VERSION == 330
+		PointLight light = pointLights[i];
+#else
+		PointLight light;
+		light.position  = lighting[7 + i * 4].xyz;
+		light.constant  = lighting[7 + i * 4].w;
+		light.ambient   = lighting[8 + i * 4].xyz;
+		light.linear    = lighting[8 + i * 4].w;
+		light.diffuse   = lighting[9 + i * 4].xyz;
+		light.quadratic = lighting[9 + i * 4].w;
+		light.specular  = lighting[10 + i * 4].xyz;
+#endif
+		result += CalcPointLight(light, norm, fragPosition, viewDir);
+	}
+
+#if RIM_LIGHT
+	finalColor = vec4(mix(CalcRimLight(viewDir, fragNormal), result, 0.7), 0.7);
+#else
+	finalColor = vec4(result * 0.7, 0.7);
+#endif
+}
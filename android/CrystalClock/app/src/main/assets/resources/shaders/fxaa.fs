@@ -1,7 +1,3 @@
-#version 100
-
-precision mediump float;
-
 varying vec2 fragTexCoord;
 varying vec4 fragColor;
 
@@ -68,7 +64,7 @@ vec4 fxaa(sampler2D tex, vec2 fragCoord) {
 
 void main()
 {
-	gl_FragColor = fxaa(texture0, gl_FragCoord.xy);
+	finalColor = fxaa(texture0, gl_FragCoord.xy);
 }
 
 
@@ -0,0 +1,32 @@
+attribute vec4 vertexPosition; // xyz: centerline point on a unit orbit, w: age (seconds)
+attribute vec4 vertexPrevious;
+attribute vec4 vertexNext;
+attribute float vertexSide;
+
+uniform mat4 mvp;
+uniform vec3 viewDir;
+uniform vec3 cameraUp;
+uniform vec4 trailColor;
+
+uniform float radius;
+uniform float width;
+uniform float fadeTime;
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+void main()
+{
+	vec3 lineDir = vertexNext.xyz - vertexPrevious.xyz;
+	vec3 side    = cross(viewDir, lineDir);
+	
+	if (dot(side, side) < 1e-12)
+		side = cross(cameraUp, lineDir);
+	
+	vec3 position = vertexPosition.xyz * radius + normalize(side) * width * vertexSide;
+	float fade    = mix(1.0, 0.1, clamp(vertexPosition.w / fadeTime, 0.0, 1.0));
+	
+	fragTexCoord = vec2(0.0);
+	fragColor    = vec4(trailColor.rg * fade, trailColor.b, trailColor.a * fade);
+    gl_Position  = mvp * vec4(position, 1.0);
+}
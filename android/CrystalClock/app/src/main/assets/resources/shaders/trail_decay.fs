@@ -0,0 +1,13 @@
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+uniform float decay;
+
+void main()
+{
+	// Subtract one 8-bit step so rounding never leaves a ghost trail behind
+	vec4 texelColor = texture2D(texture0, fragTexCoord);
+	finalColor      = max(texelColor * decay - 1.0 / 255.0, 0.0);
+}
@@ -1,5 +1,3 @@
-#version 100
-
 attribute vec3 vertexPosition;
 attribute vec2 vertexTexCoord;
 attribute vec3 vertexNormal;
@@ -19,6 +17,6 @@ void main()
     fragTexCoord = vertexTexCoord;
     fragColor    = vertexColor;
 	fragPosition = vec3(model * vec4(vertexPosition, 1.0));
-	normal       = mat3(mNormal) * vertexNormal;
+	normal       = mat3(mNormal[0].xyz, mNormal[1].xyz, mNormal[2].xyz) * vertexNormal;
     gl_Position  = mvp * vec4(vertexPosition, 1.0);
-}
\ No newline at end of file
+}
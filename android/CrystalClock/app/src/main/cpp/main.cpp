@@ -65,6 +65,7 @@ int main(int argc, char** argv)
 
     SetTextSize(textSizePx);
     SetWindowResolution(res.first, res.second);
+    SetCacheDirectory(GetAndroidApp()->activity->internalDataPath);
     SetFadeIn(false);
     SetShowTime(false);
 
@@ -97,6 +98,7 @@ Java_com_rrtry_crystalclock_RLWallpaperService_nativeInit(JNIEnv *env, jobject t
     env->ReleaseStringUTFChars(internal_data_path, chars);
 
     SetWindowResolution(ANativeWindow_getWidth(wallpaperWindow), ANativeWindow_getHeight(wallpaperWindow));
+    SetCacheDirectory(filesDirPath);
     SetPlaySound(false);
     SetFadeIn(false);
     SetShowTime(false);
@@ -0,0 +1,49 @@
+// Crystal prisms. GLSL 330 draws all prisms as instances of one draw call.
+
+attribute vec3 vertexPosition;
+attribute vec2 vertexTexCoord;
+attribute vec3 vertexNormal;
+attribute vec4 vertexColor;
+
+#if GLSL_VERSION == 330
+// Per-instance prism transform
+in mat4 instanceModel;
+in mat3 instanceNormal;
+in float instanceScale;
+
+uniform mat4 mvp;         // View-projection only, the model transform comes per instance
+uniform vec3 prismOffset;
+
+// The hour rod is the last instance and is drawn over the prisms like a pass without depth writes
+#define HOUR_ROD 12
+#else
+uniform mat4 mvp;
+uniform mat4 model;
+uniform mat4 mNormal;
+#endif
+
+varying vec2 fragTexCoord;
+varying vec3 fragPosition;
+varying vec3 fragNormal;
+varying vec4 fragColor;
+
+void main()
+{
+	fragTexCoord = vertexTexCoord * 2.0;
+    fragColor    = vertexColor;
+
+#if GLSL_VERSION == 330
+	fragNormal   = normalize(instanceNormal * vertexNormal);
+	fragPosition = vec3(instanceModel * vec4(vertexPosition, 1.0));
+
+	vec3 position = vertexPosition * vec3(1.0, instanceScale, 1.0) + prismOffset;
+    gl_Position   = mvp * instanceModel * vec4(position, 1.0);
+
+    if (gl_InstanceID == HOUR_ROD)
+        gl_Position.z = -0.999 * gl_Position.w;
+#else
+	fragNormal   = normalize(mat3(mNormal[0].xyz, mNormal[1].xyz, mNormal[2].xyz) * vertexNormal);
+	fragPosition = vec3(model * vec4(vertexPosition, 1.0));
+    gl_Position  = mvp * vec4(vertexPosition, 1.0);
+#endif
+}
@@ -0,0 +1,16 @@
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+void main()
+{
+	// Glyph edge is at 0.5, smooth over one screen pixel at any text size.
+	// The atlas is flat away from the edges, smoothstep is undefined for a zero width.
+	float distance = texture2D(texture0, fragTexCoord).a - 0.5;
+	float pixel    = max(length(vec2(dFdx(distance), dFdy(distance))), 1e-4);
+	float alpha    = smoothstep(-pixel, pixel, distance);
+
+	finalColor = vec4(fragColor.rgb, fragColor.a * alpha);
+}
@@ -0,0 +1,83 @@
+attribute vec3 vertexPosition; // x: orb index, y: sample index, z: ribbon side (-1/+1)
+
+uniform mat4 mvp;
+uniform vec3 viewDir;
+uniform vec3 cameraUp;
+uniform vec4 trailColor;
+
+uniform float radius;
+uniform float width;
+uniform float fadeTime;
+uniform float sampleStep;
+
+uniform float secondsInMinute;
+uniform float minuteKeyframe; // Current minute mod 3
+uniform float hourAngle;
+
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+
+const float PI         = 3.14159265;
+const float X_SPEED    = PI / 2.0;
+const float Z_SPEED    = -PI;
+const float ANGLE_STEP = 6.0 * PI / 180.0;
+
+float GetKeyframeAngle(float keyframe)
+{
+	keyframe = mod(keyframe, 3.0);
+	if (keyframe < 0.5) return PI / 2.0;
+	if (keyframe < 1.5) return PI + PI / 6.0;
+	return 0.0;
+}
+
+vec3 RotateX(vec3 v, float angle)
+{
+	float c = cos(angle);
+	float s = sin(angle);
+	return vec3(v.x, c * v.y - s * v.z, s * v.y + c * v.z);
+}
+
+vec3 RotateZ(vec3 v, float angle)
+{
+	float c = cos(angle);
+	float s = sin(angle);
+	return vec3(c * v.x - s * v.y, s * v.x + c * v.y, v.z);
+}
+
+// Mirrors GetOrbitTime/GetRotationMatrix/GetOrbPosition in orbit.cpp
+vec3 GetOrbPosition(float orbIndex, float offset)
+{
+	float t        = secondsInMinute - offset;
+	float rollover = floor(t / 60.0);
+	float keyframe = minuteKeyframe + rollover;
+	t -= rollover * 60.0;
+	
+	float from = GetKeyframeAngle(keyframe);
+	float to   = GetKeyframeAngle(keyframe + 1.0);
+	float ax   = X_SPEED * t + mix(from, to, t / 60.0);
+	float az   = Z_SPEED * t;
+	
+	float angle = t * orbIndex * ANGLE_STEP;
+	vec3 position = vec3(radius * cos(angle), radius * sin(angle), 0.0);
+	return RotateZ(RotateX(RotateZ(position, az), ax), hourAngle);
+}
+
+void main()
+{
+	float orbIndex = vertexPosition.x;
+	float age      = vertexPosition.y * sampleStep;
+	
+	vec3 center  = GetOrbPosition(orbIndex, age);
+	vec3 lineDir = GetOrbPosition(orbIndex, age - sampleStep) - GetOrbPosition(orbIndex, age + sampleStep);
+	vec3 side    = cross(viewDir, lineDir);
+	
+	if (dot(side, side) < 1e-12)
+		side = cross(cameraUp, lineDir);
+	
+	vec3 position = center + normalize(side) * width * vertexPosition.z;
+	float fade    = mix(1.0, 0.1, clamp(age / fadeTime, 0.0, 1.0));
+	
+	fragTexCoord = vec2(0.0);
+	fragColor    = vec4(trailColor.rg * fade, trailColor.b, trailColor.a * fade);
+    gl_Position  = mvp * vec4(position, 1.0);
+}
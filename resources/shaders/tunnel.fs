@@ -1,7 +1,3 @@
-#version 100
-
-precision mediump float;
-
 varying vec2 fragTexCoord;
 varying vec4 fragColor;
 
@@ -32,7 +28,10 @@ const vec3 secondaryColor = vec3(0.18, 0.10, 0.32);
 vec3 SampleNoise()
 {
 	vec2 texCoord = fragTexCoord + vec2(time, 0.0);
-	float noise   = texture2D(texture0, fract(texCoord)).r;
+#if GLSL_VERSION == 100
+	texCoord      = fract(texCoord);
+#endif
+	float noise   = texture2D(texture0, texCoord).r;
 	float t 	  = smoothstep(0.0, 1.0, noise);
 	return mix(mainColor * 1.25, secondaryColor, t);
 }
@@ -65,6 +64,6 @@ void main()
 	vec3 fragVec = viewPos - fragPosition;
 	float fade   = 1.0 - smoothstep(0.0, 100.0, length(fragVec));
 	vec4 color   = vec4(CalcPointLight(tunlight, normalize(normal), fragPosition, normalize(fragVec)), fade);
-	gl_FragColor = color;
+	finalColor   = color;
 }
 
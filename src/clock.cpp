@@ -2,21 +2,22 @@
 #include "raymath.h"
 #include "rlgl.h"
 #include "timeinfo.h"
+#include "orbit.h"
+#include "trail.h"
+#include "prisms.h"
+#include "transform.h"
+#include "lighting.h"
+#include "shaders.h"
+#include "uniforms.h"
+#include "workers.h"
 #include "config.h"
 
 #include <iostream>
 #include <clocale>
 #include <vector>
 
-#if defined(PLATFORM_WEB) || defined(PLATFORM_ANDROID)
-    #define GLSL_VERSION 100
-#else
-    #define GLSL_VERSION 330
-#endif
-
 using namespace std;
 
-const Color TRAIL_COLOR = { 133, 255, 255, 255 };
 const Vector3 PRISM_COLORS[] = {
     { 0.04f, 0.23f, 0.46f },
     { 0.17f, 0.03f, 0.45f },
@@ -25,11 +26,6 @@ const Vector3 PRISM_COLORS[] = {
 
 const char* WINDOW_TITLE = "CrystalClock";
 
-const int ORBS           = 7;
-const int TRAIL_SEGMENTS = 120;
-const int TRAIL_POINTS   = TRAIL_SEGMENTS + 1;
-
-const float TRAIL_WIDTH       = 1.0f;
 const float ORB_SCALE         = 2.5f;
 const float MAX_SPHERE_RADIUS = 6.0f;
 const float MIN_SPHERE_RADIUS = MAX_SPHERE_RADIUS / 2;
@@ -38,13 +34,15 @@ const float SPHERE_SCALE_TIME = 1.5f;
 const float PRISM_SCALE_TIME  = 1.5f;
 const float FADE_TIME         = 2.0f;
 const float START_FADE_TIME   = 4.0f;
-const float TRAIL_FADE_TIME   = 2000.f;
 
-const float FIXED_FOV  = 70.f;
-const float X_SPEED    = PI / 2;
-const float Z_SPEED    = -PI;
-const float ANGLE_STEP = 360.f / 60.f;
-const float ANGLES[]   = { PI / 2, PI + PI / 6, 0.f };
+const float FIXED_FOV = 70.f;
+
+const char* HUD_FONT_PATH    = "resources/fonts/hud.ttf";
+const int   HUD_FONT_SIZE    = 48;  // Glyph size in the SDF atlas, any text size is drawn from it
+const int   HUD_FONT_GLYPHS  = 224; // Codepoints 32 - 255, same range as the default font
+const float HUD_TEXT_SPACING = 1.f;
+
+const int LOW_QUALITY_POINT_LIGHTS = 3; // Orbs lighting the crystal with -quality low
 
 const double CAMERA_NEAR_PLANE = 0.1;
 const double CAMERA_FAR_PLANE  = 100.0;
@@ -65,8 +63,11 @@ Camera camera;
 // Config / Locale
 //------------------------------------------------------------------------------------
 Config cfg = { 0 };
-const char* timeLocale;
+TimeText timeText;
+TimeZone timeZone;
+bool useTimeZone = false; // Show the configured zone instead of the process TZ
 int textSize = 30;
+string cacheDirectory = "cache"; // Writable, shader program binaries are kept in its shaders/ subdirectory
 
 //------------------------------------------------------------------------------------
 // Music stream
@@ -78,12 +79,18 @@ Music ambience;
 //------------------------------------------------------------------------------------
 RenderTexture tunnelLayer;
 RenderTexture clockLayer;
+RenderTexture hudLayer;   // Date and time text, redrawn only when it changes
+bool hudDirty = true;
 
 //------------------------------------------------------------------------------------
 // Models
 //------------------------------------------------------------------------------------
 Model prism;
+PrismBatch prismBatch;
 Model tube;
+TrailMesh trailMesh;
+ProceduralTrail proceduralTrail;
+FeedbackTrail feedbackTrail;
 
 //------------------------------------------------------------------------------------
 // Textures
@@ -91,6 +98,7 @@ Model tube;
 Texture2D normalTexture;
 Texture2D noiseTexture;
 Texture2D orbTexture;
+Font hudFont; // SDF font, texture id 0 when no TTF is provided
 
 //------------------------------------------------------------------------------------
 // Shaders
@@ -98,7 +106,31 @@ Texture2D orbTexture;
 Shader crystalShader;
 Shader tunnelShader;
 Shader orbShader;
+Shader trailShader;
 Shader fxaaShader;
+Shader sdfShader;
+
+//------------------------------------------------------------------------------------
+// Shader uniforms, resolved once in LoadResources
+//------------------------------------------------------------------------------------
+typedef struct
+{
+    UniformVec3 viewPos;
+} CrystalUniforms;
+
+typedef struct
+{
+    UniformFloat time;
+    UniformMatrix model;
+    UniformMatrix normal;
+    UniformVec3 viewPos;
+    UniformVec3 lightPosition;
+} TunnelUniforms;
+
+CrystalUniforms crystalUniforms;
+Lighting crystalLighting; // Material and lights, uploaded once per frame
+TunnelUniforms tunnelUniforms;
+UniformVec2 fxaaResolution;
 
 //------------------------------------------------------------------------------------
 // Input variables
@@ -111,7 +143,12 @@ Matrix TN = MatrixInvert(MatrixTranspose(TM));
 // Time structs
 Time currentTime;
 ElapsedSeconds elapsedSeconds;
-Duration frameDuration;
+
+// Orb trails
+double wallTime; // Seconds since epoch of currentTime
+OrbitAnchor orbitAnchor;
+FrameTransforms frameTransforms;
+TrailHistory trailHistory;
 
 Vector3 clockPosition = { 0.0f, MAX_SPHERE_RADIUS + 0.5f, 0.0f };
 Vector3 prismColor;
@@ -139,6 +176,11 @@ bool fadeIn    = true;
 bool showTime  = true;
 bool playSound = true;
 
+int trailMode   = TRAIL_MODE_HISTORY;
+int trailBudget = 0; // Vertex limit of history trails, 0 = no limit
+
+int shaderQuality = SHADER_QUALITY_HIGH;
+
 Color clockLayerTint = WHITE;
 Color orbLayerTint   = WHITE;
 
@@ -148,221 +190,93 @@ Color orbLayerTint   = WHITE;
 int currentGesture = GESTURE_NONE;
 int lastGesture    = GESTURE_NONE;
 
-//------------------------------------------------------------------------------------
-// Math functions
-//------------------------------------------------------------------------------------
-float GetOrbRotationAngle(float time, int i)
-{
-    return time * i * ANGLE_STEP * DEG2RAD;
-}
-
-float GetClockRotationAngle(float hour)
-{
-    return hour < 12 ? hour * -30.0f : (hour - 12) * -30.0f;
-}
-
-float GetCurrentHourRotationAngle(const ElapsedSeconds& s)
-{
-    float elapsedHours = (float)fmod(s.day / 3600, 24);
-    return (90.f + GetClockRotationAngle(elapsedHours)) * DEG2RAD;
-}
-
-float LerpXRotationAngle(const ElapsedSeconds& s, const Time& t)
-{
-    return Lerp(ANGLES[t.minute % 3], ANGLES[(t.minute + 1) % 3], Normalize(s.minute, 0.f, 60.f));
-}
-
-Matrix GetRotationMatrix(const ElapsedSeconds& s, const Time& t, float hourAngle)
-{
-    float ax = X_SPEED * s.minute + LerpXRotationAngle(s, t);
-    float az = Z_SPEED * s.minute;
-
-    Matrix rx = MatrixRotateX(ax);
-    Matrix rz = MatrixRotateZ(az);
-
-    return MatrixMultiply(MatrixMultiply(rz, rx), MatrixRotateZ(hourAngle));
-}
-
-Vector3 GetOrbPosition(float time, float radius, int orbIndex, const Matrix& rotation)
-{
-    float angle = GetOrbRotationAngle(time, orbIndex);
-    return Vector3Transform(
-            { radius * cosf(angle), radius * sinf(angle), 0.f },
-            rotation
-    );
-}
-
-Vector3 GetOrbPosition(const TimePoint& prevTimePoint, float radius, float hourAngle, int orbIndex)
-{
-    Time prevTime;
-    ElapsedSeconds prevSeconds;
-
-    GetTimeInfo(&prevTime, prevTimePoint);
-    GetElapsedSeconds(&prevSeconds, prevTime);
-
-    Matrix rotation = GetRotationMatrix(prevSeconds, prevTime, hourAngle);
-    return GetOrbPosition(prevSeconds.minute, radius, orbIndex, rotation);
-}
-
-void GetOrbPositions(const TimePoint& prevTimePoint, Vector3* positions, float radius, float hourAngle, int orbIndex)
-{
-    Vector3 currentPosition  = GetOrbPosition(prevTimePoint, radius, hourAngle, orbIndex);
-    Vector3 previousPosition = GetOrbPosition(prevTimePoint - frameDuration, radius, hourAngle, orbIndex);
-    Vector3 nextPosition     = GetOrbPosition(prevTimePoint + frameDuration, radius, hourAngle, orbIndex);
-
-    positions[0] = previousPosition;
-    positions[1] = currentPosition;
-    positions[2] = nextPosition;
-}
-
-Vector3 GetSegmentNormal(Vector3* positions, const TimePoint& prevTimePoint, int pointIndex)
-{
-    Vector3 lineDir;
-    Vector3 previousPosition = positions[0];
-    Vector3 currentPosition  = positions[1];
-    Vector3 nextPosition     = positions[2];
-
-    if (pointIndex == 0) 
-    {
-        lineDir = Vector3Normalize(Vector3Subtract(nextPosition, currentPosition));
-    } 
-    else if (pointIndex == (TRAIL_POINTS - 1)) 
-    {
-        lineDir = Vector3Normalize(Vector3Subtract(currentPosition, previousPosition));
-    }
-    else 
-    {
-        lineDir = Vector3Normalize(Vector3Add(
-            Vector3Subtract(currentPosition, previousPosition), 
-            Vector3Subtract(nextPosition, currentPosition))
-        );
-    }
-
-    Vector3 viewDir = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
-    Vector3 side    = Vector3CrossProduct(viewDir, lineDir);
-
-    if (FloatEquals(Vector3Length(side), 0.f)) 
-        side = Vector3CrossProduct(camera.up, lineDir);
-    
-    side = Vector3Normalize(side);
-    return Vector3Scale(side, TRAIL_WIDTH * 0.1f * 0.5f);
-}
-
-float GetSegmentAlpha(const TimePoint& prevTimePoint)
-{
-    auto now    = currentTime.timePoint;
-    auto diff   = now - prevTimePoint;
-    auto millis = chrono::duration_cast<chrono::milliseconds>(diff).count();
-    return Lerp(1.0f, 0.1f, Normalize(millis, 0.f, TRAIL_FADE_TIME));
-}
 //------------------------------------------------------------------------------------
 // Drawing functions
 //------------------------------------------------------------------------------------
-void DrawTrail(TimePoint prevTimePoint, float radius, float hourAngle, int orbIndex)
-{
-    Vector3 positions[3];
-    for (int i = 0; i < TRAIL_POINTS - 1; i++)
-    {
-        GetOrbPositions(prevTimePoint, positions, radius, hourAngle, orbIndex);
-        
-        Vector3 P0 = positions[1];
-        Vector3 P1 = positions[2];
-        Vector3 N0 = GetSegmentNormal(positions, prevTimePoint, i);
-        Vector3 N1 = GetSegmentNormal(positions, prevTimePoint, i + 1);
-
-        Vector3 A = Vector3Add(P0, N0);
-        Vector3 B = Vector3Subtract(P0, N0);
-        Vector3 C = Vector3Add(P1, N1);
-        Vector3 D = Vector3Subtract(P1, N1);
-
-        float fade = GetSegmentAlpha(prevTimePoint);
-        Color col  = {
-            (unsigned char)(TRAIL_COLOR.r * fade),
-            (unsigned char)(TRAIL_COLOR.g * fade),
-            TRAIL_COLOR.b,
-            (unsigned char)(TRAIL_COLOR.a * fade)
-        };
-
-        DrawTriangle3D(A, B, C, col);
-        DrawTriangle3D(C, B, D, col);
-
-        prevTimePoint -= frameDuration;
-    }
-}
-
 void DrawOrbs(float radius)
 {
-    float hourAngle = GetCurrentHourRotationAngle(elapsedSeconds);
-    Matrix rotation = GetRotationMatrix(elapsedSeconds, currentTime, hourAngle);
     Vector3 orbPosition;
 
     for (int i = 0; i < ORBS; i++)
     {
-        orbPosition = GetOrbPosition(elapsedSeconds.minute, radius, i, rotation);
-        SetShaderValue(
-                prism.materials[0].shader,
-                GetShaderLocation(prism.materials[0].shader, TextFormat("pointLights[%d].position", i)),
-                &orbPosition,
-                RL_SHADER_UNIFORM_VEC3
-        );
+        orbPosition = Vector3Scale(frameTransforms.orbs[i], radius);
+        crystalLighting.block.pointLights[i].position = orbPosition;
 
         BeginShaderMode(orbShader);
             DrawBillboard(camera, orbTexture, orbPosition, ORB_SCALE, WHITE);
             DrawBillboard(camera, orbTexture, orbPosition, ORB_SCALE * 0.5, WHITE);
         EndShaderMode();
+    }
 
-        DrawTrail(currentTime.timePoint, radius, hourAngle, i);
+    if (trailMode == TRAIL_MODE_PROCEDURAL)
+    {
+        DrawProceduralTrail(proceduralTrail, orbitAnchor, radius);
+    }
+    else if (trailMode == TRAIL_MODE_HISTORY)
+    {
+        SwapTrailMesh(&trailMesh);
+        DrawTrailMesh(trailMesh);
     }
 }
 
-void DrawClock(float secOfMinRotation, float hourOfDayRotation, float hourPrismScale)
+void DrawClock(const FrameTransforms& transforms, float hourPrismScale)
 {
-    float angle = 0.0f;
-    for (int i = 0; i < 12; i++)
+    for (int i = 0; i < PRISMS; i++)
+        SetPrismTransform(&prismBatch, i, transforms.prisms[i], transforms.prisms[i], 1.f);
+
+    SetPrismTransform(&prismBatch, PRISM_HOUR_ROD, transforms.prisms[0], transforms.prisms[0], hourPrismScale);
+    DrawPrismBatch(&prismBatch, clockPosition);
+}
+
+void UpdateDateTime()
+{
+    int hudHeight = textSize + 20;
+    if (hudLayer.texture.width != screenWidth || hudLayer.texture.height != hudHeight)
     {
-        Matrix M, N, R;
-        R = MatrixRotateY(secOfMinRotation * 4.f * DEG2RAD);
-        M = MatrixIdentity();
-        M = MatrixMultiply(M, MatrixRotateZ(angle * DEG2RAD));
-        M = MatrixMultiply(M, MatrixRotateY(-secOfMinRotation * DEG2RAD));
-        M = MatrixMultiply(M, MatrixRotateZ(hourOfDayRotation * DEG2RAD));
-        M = MatrixMultiply(R, M);
-        N = MatrixTranspose(MatrixInvert(M));
-
-        rlPushMatrix();
-
-        rlMultMatrixf(MatrixToFloat(M));
-        SetShaderValueMatrix(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "model"),   M);
-        SetShaderValueMatrix(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "mNormal"), N);
-
-        if (i == 0)
-        {
-            rlDisableDepthMask();
-            DrawModelEx(
-                    prism,
-                    clockPosition,
-                    { 0.f, 0.f, 0.f },
-                    0.f,
-                    { 1.f, hourPrismScale, 1.f },
-                    WHITE
-            );
-            rlEnableDepthMask();
-        }
-        DrawModel(prism, clockPosition, 1.f, WHITE);
+        if (hudLayer.id > 0)
+            UnloadRenderTexture(hudLayer);
 
-        rlPopMatrix();
-        angle -= 30.f;
+        hudLayer = LoadRenderTexture(screenWidth, hudHeight);
+        hudDirty = true;
     }
+
+    if (!UpdateTimeText(&timeText, currentTime) && !hudDirty)
+        return;
+
+    BeginTextureMode(hudLayer);
+        ClearBackground(BLANK);
+
+        // Stores the text premultiplied by its alpha, whatever blend mode the frame left set
+        BeginBlendMode(BLEND_ADDITIVE);
+            if (hudFont.texture.id > 0)
+            {
+                float size     = (float)textSize;
+                float timeSize = MeasureTextEx(hudFont, timeText.time, size, HUD_TEXT_SPACING).x;
+
+                BeginShaderMode(sdfShader);
+                    DrawTextEx(hudFont, timeText.date, { 10.f, 10.f }, size, HUD_TEXT_SPACING, WHITE);
+                    DrawTextEx(hudFont, timeText.time, { screenWidth - timeSize - 10.f, 10.f }, size, HUD_TEXT_SPACING, WHITE);
+                EndShaderMode();
+            }
+            else
+            {
+                int timeSize = MeasureText(timeText.time, textSize);
+                DrawText(timeText.date, 10, 10, textSize, WHITE);
+                DrawText(timeText.time, screenWidth - timeSize - 10, 10, textSize, WHITE);
+            }
+        EndBlendMode();
+    EndTextureMode();
+
+    hudDirty = false;
 }
 
 void DrawDateTime()
 {
-    string dateStr = FormatDate(currentTime, timeLocale);
-    string timeStr = FormatTime(currentTime, timeLocale);
-
-    int timeSize = MeasureText(timeStr.c_str(), textSize);
-    DrawText(dateStr.c_str(), 10, 10, textSize, WHITE);
-    DrawText(timeStr.c_str(), screenWidth - timeSize - 10, 10, textSize, WHITE);
+    // Text color is already multiplied by its alpha, add it the way DrawText did
+    rlSetBlendFactors(RL_ONE, RL_ONE, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+        DrawTextureRec(hudLayer.texture, { 0, 0, (float)hudLayer.texture.width, (float)-hudLayer.texture.height }, { 0, 0 }, WHITE);
+    EndBlendMode();
 }
 
 //------------------------------------------------------------------------------------
@@ -432,6 +346,12 @@ void SetFadeIn(bool fade)
 void SetTextSize(int px)
 {
     textSize = px;
+    hudDirty = true;
+}
+
+void SetCacheDirectory(const char* path)
+{
+    cacheDirectory = path;
 }
 
 void SetWindowResolution(int width, int height)
@@ -442,8 +362,9 @@ void SetWindowResolution(int width, int height)
 
 void SetTimeLocale()
 {
+    // Date and time text is formatted with strftime in this locale
     setlocale(LC_ALL, "");
-    timeLocale = setlocale(LC_TIME, nullptr);
+    ResetTimeText(&timeText);
 }
 
 bool ParseConfig(int argc, char** argv, bool prefsOnly)
@@ -467,6 +388,16 @@ bool ParseConfig(int argc, char** argv, bool prefsOnly)
 
     playSound = (cfg.preferenceFlags & FLAG_NO_SOUND)   == 0;
     fadeIn    = (cfg.preferenceFlags & FLAG_NO_FADE_IN) == 0;
+    trailMode   = cfg.trailMode;
+    trailBudget = cfg.trailBudget;
+    shaderQuality = cfg.shaderQuality;
+
+    // The start time of day is a wall time in the displayed zone
+    useTimeZone = cfg.timeZone[0] != '\0' && LoadTimeZone(&timeZone, cfg.timeZone);
+    if (cfg.timeZone[0] != '\0' && !useTimeZone)
+        cerr << "Could not load time zone " << cfg.timeZone << ", using local time" << endl;
+
+    InitClockSource(cfg.clockMode, cfg.clockRate, cfg.clockStart, useTimeZone ? &timeZone : NULL);
 
     return true;
 }
@@ -540,7 +471,69 @@ void LoadAudio()
 void SetShaderResolution()
 {
     Vector2 res = { (float)screenWidth, (float)screenHeight };
-    SetShaderValue(fxaaShader, GetShaderLocation(fxaaShader, "resolution"), &res, SHADER_UNIFORM_VEC2);
+    SetUniform(&fxaaResolution, res);
+}
+
+// Signed distance field atlas generated once from a TTF, stays sharp at any text size
+void LoadHudFont()
+{
+    hudFont = { 0 };
+
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(HUD_FONT_PATH, &dataSize);
+    if (data == NULL)
+        return;
+
+    int codepoints[HUD_FONT_GLYPHS];
+    for (int i = 0; i < HUD_FONT_GLYPHS; i++)
+        codepoints[i] = 32 + i;
+
+    hudFont.baseSize   = HUD_FONT_SIZE;
+    hudFont.glyphCount = HUD_FONT_GLYPHS;
+    hudFont.glyphs     = LoadFontData(data, dataSize, HUD_FONT_SIZE, codepoints, HUD_FONT_GLYPHS, FONT_SDF);
+    UnloadFileData(data);
+
+    if (hudFont.glyphs == NULL)
+    {
+        hudFont = { 0 };
+        return;
+    }
+
+    Image atlas = GenImageFontAtlas(hudFont.glyphs, &hudFont.recs, HUD_FONT_GLYPHS, HUD_FONT_SIZE, 0, 1);
+    hudFont.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+
+    SetTextureFilter(hudFont.texture, TEXTURE_FILTER_BILINEAR);
+    sdfShader = LoadShaderVariant(NULL, "resources/shaders/sdf.fs", NULL);
+}
+
+Shader LoadTrailShader()
+{
+    switch (trailMode)
+    {
+    case TRAIL_MODE_PROCEDURAL:
+        return LoadShaderVariant("resources/shaders/trail_procedural.vs", NULL, NULL);
+    case TRAIL_MODE_FEEDBACK:
+        return LoadShaderVariant(NULL, "resources/shaders/trail_decay.fs", NULL);
+    default:
+        return LoadShaderVariant("resources/shaders/trail.vs", NULL, NULL);
+    }
+}
+
+int GetCrystalPointLights()
+{
+    return shaderQuality == SHADER_QUALITY_LOW ? LOW_QUALITY_POINT_LIGHTS : ORBS;
+}
+
+Shader LoadCrystalShader()
+{
+    bool normalMap = shaderQuality == SHADER_QUALITY_HIGH && normalTexture.id > 0;
+    bool rimLight  = shaderQuality != SHADER_QUALITY_LOW;
+
+    const char* defines = TextFormat("#define NR_POINT_LIGHTS %i\n#define NORMAL_MAP %i\n#define RIM_LIGHT %i\n",
+                                     GetCrystalPointLights(), normalMap ? 1 : 0, rimLight ? 1 : 0);
+
+    return LoadShaderVariant("resources/shaders/crystal.vs", "resources/shaders/crystal.fs", defines);
 }
 
 void LoadResources()
@@ -564,16 +557,32 @@ void LoadResources()
     orbTexture    = LoadTexture("resources/textures/halo.png");
 
     int normalMap = MATERIAL_MAP_NORMAL;
-    GenMeshTangents(&(prism.meshes[0]));
 
     //------------------------------------------------------------------------------------
     // Shaders/materials
     //------------------------------------------------------------------------------------
-    string glslDirectory = "resources/shaders/glsl" + to_string(GLSL_VERSION);
-    crystalShader = LoadShader((glslDirectory + "/crystal.vs").c_str(), (glslDirectory + "/crystal.fs").c_str());
-    tunnelShader  = LoadShader((glslDirectory + "/tunnel.vs").c_str(),  (glslDirectory + "/tunnel.fs").c_str());
-    orbShader     = LoadShader(0, (glslDirectory + "/orb.fs").c_str());
-    fxaaShader    = LoadShader(0, "resources/shaders/fxaa.fs");
+    SetShaderCacheDirectory((cacheDirectory + "/shaders").c_str());
+
+    crystalShader = LoadCrystalShader();
+    tunnelShader  = LoadShaderVariant("resources/shaders/tunnel.vs", "resources/shaders/tunnel.fs", NULL);
+    orbShader     = LoadShaderVariant(NULL, "resources/shaders/orb.fs", NULL);
+    trailShader   = LoadTrailShader();
+    fxaaShader    = LoadShaderVariant(NULL, "resources/shaders/fxaa.fs", NULL);
+
+    LoadHudFont();
+
+    //------------------------------------------------------------------------------------
+    // Per-frame uniforms
+    //------------------------------------------------------------------------------------
+    crystalUniforms.viewPos = GetUniformVec3(crystalShader, "viewPos");
+
+    tunnelUniforms.time          = GetUniformFloat(tunnelShader, "time");
+    tunnelUniforms.model         = GetUniformMatrix(tunnelShader, "model");
+    tunnelUniforms.normal        = GetUniformMatrix(tunnelShader, "mNormal");
+    tunnelUniforms.viewPos       = GetUniformVec3(tunnelShader, "viewPos");
+    tunnelUniforms.lightPosition = GetUniformVec3(tunnelShader, "tunlight.position");
+
+    fxaaResolution = GetUniformVec2(fxaaShader, "resolution");
 
     //------------------------------------------------------------------------------------
     // Set resolution for antialiasing shader
@@ -583,49 +592,40 @@ void LoadResources()
     //------------------------------------------------------------------------------------
     // Crystal rod
     //------------------------------------------------------------------------------------
-    Vector3 crystalAmbient   = { 0.04f, 0.23f, 0.46f };
-    Vector3 crystalDiffuse   = { 0.04f, 0.23f, 0.46f };
-    Vector3 crystalSpecular  = { 1.0f,  1.0f,  1.0f  };
-    float   crystalShininess = 0.4f;
-
-    Vector3 orbLightAmbient   = { 0.5f, 0.5f, 0.5f };
-    Vector3 orbLightDiffuse   = { 0.8f, 0.8f, 0.8f };
-    Vector3 orbLightSpecular  = { 1.0f, 1.0f, 1.0f };
-
-    Vector3 dirLightAmbient  = { 0.5f, 0.5f,  0.5f  };
-    Vector3 dirLightDiffuse  = { 0.8f, 0.8f,  0.8f  };
-    Vector3 dirLightSpecular = { 0.5f, 0.5f,  0.5f  };
-    Vector3 lightDirection   = { 0.0f, 0.0f,  -1.0f };
-
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "material.ambient"),   &crystalAmbient,   RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "material.diffuse"),   &crystalDiffuse,   RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "material.specular"),  &crystalSpecular,  RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "material.shininess"), &crystalShininess, RL_SHADER_UNIFORM_FLOAT);
-
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "dirLight.direction"), &lightDirection,    RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "dirLight.ambient"),   &dirLightAmbient,   RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "dirLight.diffuse"),   &dirLightDiffuse,   RL_SHADER_UNIFORM_VEC3);
-    SetShaderValue(crystalShader, GetShaderLocation(crystalShader, "dirLight.specular"),  &dirLightSpecular,  RL_SHADER_UNIFORM_VEC3);
-
     // 13	1.0	0.35	0.44
     const float ORB_LIGHT_KC = 1.0f;
     const float ORB_LIGHT_KL = 0.7f;
     const float ORB_LIGHT_KQ = 1.8f;
 
+    crystalLighting = LoadLighting(crystalShader, GetCrystalPointLights());
+    LightingBlock& lighting = crystalLighting.block;
+
+    lighting.material.ambient   = { 0.04f, 0.23f, 0.46f };
+    lighting.material.diffuse   = { 0.04f, 0.23f, 0.46f };
+    lighting.material.specular  = { 1.0f,  1.0f,  1.0f  };
+    lighting.material.shininess = 0.4f;
+
+    lighting.dirLight.direction = { 0.0f, 0.0f, -1.0f };
+    lighting.dirLight.ambient   = { 0.5f, 0.5f,  0.5f };
+    lighting.dirLight.diffuse   = { 0.8f, 0.8f,  0.8f };
+    lighting.dirLight.specular  = { 0.5f, 0.5f,  0.5f };
+
     for (int i = 0; i < ORBS; i++)
     {
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].ambient",   i)), &orbLightAmbient,  RL_SHADER_UNIFORM_VEC3);
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].diffuse",   i)), &orbLightDiffuse,  RL_SHADER_UNIFORM_VEC3);
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].specular",  i)), &orbLightSpecular, RL_SHADER_UNIFORM_VEC3);
+        lighting.pointLights[i].ambient  = { 0.5f, 0.5f, 0.5f };
+        lighting.pointLights[i].diffuse  = { 0.8f, 0.8f, 0.8f };
+        lighting.pointLights[i].specular = { 1.0f, 1.0f, 1.0f };
 
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].constant",  i)), &ORB_LIGHT_KC, RL_SHADER_UNIFORM_FLOAT);
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].linear",    i)), &ORB_LIGHT_KL, RL_SHADER_UNIFORM_FLOAT);
-        SetShaderValue(crystalShader, GetShaderLocation(crystalShader, TextFormat("pointLights[%d].quadratic", i)), &ORB_LIGHT_KQ, RL_SHADER_UNIFORM_FLOAT);
+        lighting.pointLights[i].constant  = ORB_LIGHT_KC;
+        lighting.pointLights[i].linear    = ORB_LIGHT_KL;
+        lighting.pointLights[i].quadratic = ORB_LIGHT_KQ;
     }
+    UploadLighting(&crystalLighting);
 
     prism.materials[0].shader = crystalShader;
     SetShaderValue(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "normalMap"), &normalMap, SHADER_UNIFORM_INT);
     prism.materials[0].maps[MATERIAL_MAP_NORMAL].texture = normalTexture;
+    prismBatch = LoadPrismBatch(prism);
 
     //------------------------------------------------------------------------------------
     // Tunnel
@@ -646,6 +646,16 @@ void LoadResources()
 
     tube.materials[0].shader = tunnelShader;
     tube.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = noiseTexture;
+
+    //------------------------------------------------------------------------------------
+    // Orb trails
+    //------------------------------------------------------------------------------------
+    if (trailMode == TRAIL_MODE_PROCEDURAL)
+        proceduralTrail = LoadProceduralTrail(trailShader, camera);
+    else if (trailMode == TRAIL_MODE_FEEDBACK)
+        feedbackTrail = LoadFeedbackTrail(trailShader, screenWidth, screenHeight);
+    else
+        trailMesh = LoadTrailMesh(trailShader, camera, trailBudget);
 }
 
 void UnloadResources()
@@ -661,16 +671,33 @@ void UnloadResources()
     UnloadTexture(noiseTexture);
     UnloadTexture(normalTexture);
 
+    UnloadLighting(crystalLighting);
     UnloadShader(crystalShader);
     UnloadShader(orbShader);
     UnloadShader(tunnelShader);
+    UnloadShader(trailShader);
     UnloadShader(fxaaShader);
 
+    UnloadPrismBatch(prismBatch);
     UnloadModel(prism);
     UnloadModel(tube);
+    if (trailMode == TRAIL_MODE_PROCEDURAL)
+        UnloadProceduralTrail(proceduralTrail);
+    else if (trailMode == TRAIL_MODE_FEEDBACK)
+        UnloadFeedbackTrail(feedbackTrail);
+    else
+        UnloadTrailMesh(trailMesh);
 
     UnloadRenderTexture(tunnelLayer);
     UnloadRenderTexture(clockLayer);
+    UnloadRenderTexture(hudLayer);
+    hudLayer = { 0 };
+
+    if (hudFont.texture.id > 0)
+    {
+        UnloadFont(hudFont);
+        UnloadShader(sdfShader);
+    }
 }
 
 void SetRenderOptions()
@@ -700,6 +727,12 @@ void ResizeWindow()
         tunnelLayer = LoadRenderTexture(screenWidth, screenHeight);
         clockLayer  = LoadRenderTexture(screenWidth, screenHeight);
 
+        if (trailMode == TRAIL_MODE_FEEDBACK)
+        {
+            UnloadFeedbackTrail(feedbackTrail);
+            feedbackTrail = LoadFeedbackTrail(trailShader, screenWidth, screenHeight);
+        }
+
         SetWindowSize(screenWidth, screenHeight);
         SetShaderResolution();
         camera.fovy = GetVerticalFOV();
@@ -742,18 +775,35 @@ void Update()
     if (playSound)
         UpdateMusicStream(ambience);
     
-    GetTimeInfo(&currentTime);
+    TickClockSource(GetTime(), GetFrameTime());
+    if (useTimeZone)
+        GetTimeInfo(&currentTime, timeZone);
+    else
+        GetTimeInfo(&currentTime);
     GetElapsedSeconds(&elapsedSeconds, currentTime);
 
-    deltaTime       = GetFrameTime();
-    frameDuration   = chrono::milliseconds(static_cast<long long>(deltaTime * 1000.f));
-    elapsedTime     = (float)GetTime();
+    deltaTime       = (float)GetClockDeltaTime();
+    elapsedTime     = (float)GetClockElapsedTime();
     secondsInMinute = elapsedSeconds.minute;
     secondsInHour   = elapsedSeconds.hour;
 
+    wallTime = chrono::duration<double>(currentTime.timePoint.time_since_epoch()).count();
+    GetOrbitAnchor(&orbitAnchor, elapsedSeconds, currentTime);
+
+    // Trail samples of a clock before the jump no longer line up with the orbit
+    if (IsClockJumped())
+    {
+        ResetTrailHistory(&trailHistory);
+        ResetFeedbackTrail(&feedbackTrail);
+    }
+
+    if (trailMode == TRAIL_MODE_HISTORY)
+        UpdateTrailHistory(&trailHistory, orbitAnchor, wallTime);
+
     prismColor          = LerpPrismColor(elapsedSeconds.minute);
     clockMinuteRotation = LerpClockRotation(secondsInMinute);
     clockHourRotation   = GetClockRotationAngle(currentTime.hour);
+    UpdateFrameTransforms(&frameTransforms, orbitAnchor, clockMinuteRotation * DEG2RAD, clockHourRotation * DEG2RAD);
     newHour             = (int)roundf(secondsInHour) == 0 || sphereRadiusAnim > 0.f || prismScaleAnim > 0.f;
 
     //------------------------------------------------------------------------------------
@@ -813,6 +863,12 @@ void Update()
         sphereRadius = LerpSphereRadius(secondsInHour);
         prismScale   = LerpPrismScale(secondsInHour);
     }
+
+    //------------------------------------------------------------------------------------
+    // Trail geometry, built while the tunnel and clock layers render, joined in DrawOrbs
+    //------------------------------------------------------------------------------------
+    if (trailMode == TRAIL_MODE_HISTORY)
+        BuildTrailMesh(&trailMesh, trailHistory, camera, sphereRadius, screenWidth, screenHeight);
 }
 
 void RenderLayers()
@@ -839,6 +895,12 @@ void RenderLayers()
             if (showTime)
                 DrawDateTime();
         }
+        if (trailMode == TRAIL_MODE_FEEDBACK)
+            DrawFeedbackTrail(feedbackTrail);
+
+        // Custom blending above falls back to alpha blending, orbs are additive
+        rlSetBlendMode(RL_BLEND_ADDITIVE);
+
         // TODO: implement MSAA framebuffer for Android
         BeginMode3D(camera);
             rlDisableDepthMask();
@@ -859,18 +921,32 @@ void Render()
     if (showClock || fading)
     {
         float wrappedTime = fmod(elapsedTime * 0.004f, 1.0f);
-        SetShaderValue(tube.materials[0].shader, GetShaderLocation(tube.materials[0].shader, "time"), &wrappedTime, SHADER_UNIFORM_FLOAT);
+        SetUniform(&tunnelUniforms.time, wrappedTime);
+
+        SetUniform(&tunnelUniforms.model,  TM);
+        SetUniform(&tunnelUniforms.normal, TN);
 
-        SetShaderValueMatrix(tube.materials[0].shader, GetShaderLocation(tube.materials[0].shader, "model"),   TM);
-        SetShaderValueMatrix(tube.materials[0].shader, GetShaderLocation(tube.materials[0].shader, "mNormal"), TN);
+        crystalLighting.block.material.diffuse = prismColor;
+        crystalLighting.block.material.ambient = prismColor;
+        UploadLighting(&crystalLighting);
 
-        SetShaderValue(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "material.diffuse"), &prismColor,        RL_SHADER_UNIFORM_VEC3);
-        SetShaderValue(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "material.ambient"), &prismColor,        RL_SHADER_UNIFORM_VEC3);
-        SetShaderValue(prism.materials[0].shader, GetShaderLocation(prism.materials[0].shader, "viewPos"),          &(camera.position), RL_SHADER_UNIFORM_VEC3);
+        SetUniform(&crystalUniforms.viewPos, camera.position);
 
-        SetShaderValue(tube.materials[0].shader, GetShaderLocation(tube.materials[0].shader, "viewPos"),           &(camera.position),  RL_SHADER_UNIFORM_VEC3);
-        SetShaderValue(tube.materials[0].shader, GetShaderLocation(tube.materials[0].shader, "tunlight.position"), &(camera.position),  RL_SHADER_UNIFORM_VEC3);
+        SetUniform(&tunnelUniforms.viewPos,       camera.position);
+        SetUniform(&tunnelUniforms.lightPosition, camera.position);
     }
+    //------------------------------------------------------------------------------------
+    // Trail layer
+    //------------------------------------------------------------------------------------
+    if (trailMode == TRAIL_MODE_FEEDBACK)
+        UpdateFeedbackTrail(&feedbackTrail, camera, orbitAnchor, wallTime, sphereRadius);
+
+    //------------------------------------------------------------------------------------
+    // HUD layer
+    //------------------------------------------------------------------------------------
+    if ((showClock || fading) && showTime)
+        UpdateDateTime();
+
     //------------------------------------------------------------------------------------
     // Render
     //------------------------------------------------------------------------------------
@@ -906,7 +982,7 @@ void Render()
         BeginTextureMode(clockLayer);
             BeginMode3D(camera);
                 ClearBackground(Fade(BLACK, 0.0));
-                DrawClock(clockMinuteRotation, clockHourRotation, prismScale);
+                DrawClock(frameTransforms, prismScale);
             EndMode3D();
         EndTextureMode();
     }
@@ -938,6 +1014,11 @@ bool Initialize()
     //------------------------------------------------------------------------------------
     InitCamera();
 
+    //------------------------------------------------------------------------------------
+    // Worker threads
+    //------------------------------------------------------------------------------------
+    InitWorkers(0);
+
     //------------------------------------------------------------------------------------
     // Loading main models and textures
     //------------------------------------------------------------------------------------
@@ -963,6 +1044,10 @@ bool Initialize(int argc, char** argv)
 
 void Uninitialize()
 {
+    UniformStats stats = GetUniformStats();
+    TraceLog(LOG_INFO, "SHADER: Uniform uploads issued: %llu, skipped unchanged: %llu", stats.issued, stats.skipped);
+
+    CloseWorkers();
     UnloadResources();
     CloseWindow();
 }
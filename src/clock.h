@@ -10,6 +10,7 @@ void Loop();
 
 void SetWindowResolution(int width, int height);
 void SetTextSize(int px);
+void SetCacheDirectory(const char* path);
 
 void SetFadeIn(bool fade);
 void SetPlaySound(bool play);
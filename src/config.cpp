@@ -1,9 +1,13 @@
 #include "raylib.h"
 #include "config.h"
+#include "trail.h"
+#include "timeinfo.h"
+#include "shaders.h"
 
 #include <map>
 #include <fstream>
 #include <algorithm>
+#include <cstdio>
 
 using namespace std;
 
@@ -18,6 +22,24 @@ static map<Argument, int> prefFlagsMap = {
 	{ NO_FADE_IN, FLAG_NO_FADE_IN }
 };
 
+static map<string, int> trailModesMap = {
+	{ "history",    TRAIL_MODE_HISTORY    },
+	{ "procedural", TRAIL_MODE_PROCEDURAL },
+	{ "feedback",   TRAIL_MODE_FEEDBACK   }
+};
+
+static map<string, int> clockModesMap = {
+	{ "real",  CLOCK_MODE_REAL  },
+	{ "fixed", CLOCK_MODE_FIXED },
+	{ "warp",  CLOCK_MODE_WARP  }
+};
+
+static map<string, int> qualityMap = {
+	{ "high",   SHADER_QUALITY_HIGH   },
+	{ "medium", SHADER_QUALITY_MEDIUM },
+	{ "low",    SHADER_QUALITY_LOW    }
+};
+
 static map<string, CMDParameter> argsMap = {
 
 	{ CMD_WIDTH,  { WIDTH,  true }},
@@ -34,7 +56,17 @@ static map<string, CMDParameter> argsMap = {
 	{ CMD_UNDECORATED, { UNDECORATED, false }},
 
 	{ CMD_NO_FADE_IN, { NO_FADE_IN, false }},
-	{ CMD_NO_SOUND,   { NO_SOUND,   false }}
+	{ CMD_NO_SOUND,   { NO_SOUND,   false }},
+
+	{ CMD_TRAILS,       { TRAILS,       true }},
+	{ CMD_TRAIL_BUDGET, { TRAIL_BUDGET, true }},
+
+	{ CMD_CLOCK,       { CLOCK,       true }},
+	{ CMD_CLOCK_RATE,  { CLOCK_RATE,  true }},
+	{ CMD_CLOCK_START, { CLOCK_START, true }},
+
+	{ CMD_TIME_ZONE, { TIME_ZONE, true }},
+	{ CMD_QUALITY,   { QUALITY,   true }}
 };
 
 static inline void ltrim(string& s) {
@@ -62,13 +94,42 @@ static bool ParseInt(const string& cmd, int& value)
 	}
 }
 
+static bool ParseFloat(const string& cmd, float& value)
+{
+	try 
+	{
+		value = stof(cmd);
+		return true;
+	}
+	catch (exception& err)
+	{
+		return false;
+	}
+}
+
+// HH:MM or HH:MM:SS, returns seconds of the day
+static bool ParseClockTime(const string& cmd, int& value)
+{
+	int hour   = 0;
+	int minute = 0;
+	int second = 0;
+
+	int fields = sscanf(cmd.c_str(), "%d:%d:%d", &hour, &minute, &second);
+	if (fields < 2 || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59)
+		return false;
+
+	value = hour * 3600 + minute * 60 + second;
+	return true;
+}
+
 static bool ParseArgValue(Config& config,
 						  const CMDParameter& cmd, 
 						  const string& arg, 
 						  const string& argValue)
 {
-	int ivalue  = -1;
-	bool parsed = false;
+	int ivalue   = -1;
+	float fvalue = 0.f;
+	bool parsed  = false;
 
 	switch (cmd.argument)
 	{
@@ -105,6 +166,69 @@ static bool ParseArgValue(Config& config,
 		}
 		break;
 
+		case TRAILS:
+		{
+			auto search = trailModesMap.find(argValue);
+			parsed = search != trailModesMap.end();
+			if (parsed)
+				config.trailMode = search->second;
+		}
+		break;
+
+		case TRAIL_BUDGET:
+		{
+			parsed = ParseInt(argValue, ivalue) && ivalue > -1;
+			if (parsed)
+				config.trailBudget = ivalue;
+		}
+		break;
+
+		case CLOCK:
+		{
+			auto search = clockModesMap.find(argValue);
+			parsed = search != clockModesMap.end();
+			if (parsed)
+				config.clockMode = search->second;
+		}
+		break;
+
+		case CLOCK_RATE:
+		{
+			parsed = ParseFloat(argValue, fvalue) && fvalue > 0.f;
+			if (parsed)
+				config.clockRate = fvalue;
+		}
+		break;
+
+		case CLOCK_START:
+		{
+			parsed = ParseClockTime(argValue, ivalue);
+			if (parsed)
+				config.clockStart = ivalue;
+		}
+		break;
+
+		case TIME_ZONE:
+		{
+			parsed = argValue.length() < TIME_ZONE_NAME_LENGTH;
+			if (parsed)
+			{
+				// A repeated key may follow a longer name
+				argValue.copy(config.timeZone, argValue.length());
+				config.timeZone[argValue.length()] = '\0';
+			}
+		}
+		break;
+
+		case QUALITY:
+		{
+			auto search = qualityMap.find(argValue);
+			parsed = search != qualityMap.end();
+			if (parsed)
+				config.shaderQuality = search->second;
+		}
+		break;
+
 		case FULLSCREEN:
 		case BORDERLESS:
 		case UNDECORATED:
@@ -121,6 +245,7 @@ static bool ParseArgValue(Config& config,
 bool ParseCMD(Config& config, int argc, char** argv, string& err, bool prefsOnly)
 {
 	config = { 0 };
+	config.clockStart = CLOCK_START_UNSET;
 	if (!prefsOnly && argc < 5)
 	{
 		err = "Not enough arguments";
@@ -180,6 +305,7 @@ bool ParseCMD(Config& config, int argc, char** argv, string& err, bool prefsOnly
 bool ParseINI(Config& cfg, const string& path, bool prefsOnly)
 {
 	cfg = { 0 };
+	cfg.clockStart = CLOCK_START_UNSET;
     ifstream ifs(path);
 
     if (!ifs.is_open())
@@ -20,6 +20,15 @@ constexpr auto CMD_FULLSCREEN  = "-fullscreen";
 constexpr auto CMD_UNDECORATED = "-undecorated";
 constexpr auto CMD_NO_FADE_IN  = "-nofadein";
 constexpr auto CMD_NO_SOUND	   = "-nosound";
+constexpr auto CMD_TRAILS	   = "-trails";
+constexpr auto CMD_TRAIL_BUDGET = "-trailbudget";
+constexpr auto CMD_CLOCK        = "-clock";
+constexpr auto CMD_CLOCK_RATE   = "-clockrate";
+constexpr auto CMD_CLOCK_START  = "-clockstart";
+constexpr auto CMD_TIME_ZONE    = "-timezone";
+constexpr auto CMD_QUALITY      = "-quality";
+
+const int TIME_ZONE_NAME_LENGTH = 64;
 
 struct Config
 {
@@ -28,6 +37,13 @@ struct Config
 	int display;
 	int flags;
 	int preferenceFlags;
+	int trailMode;
+	int trailBudget;
+	int clockMode;
+	float clockRate;
+	int clockStart; // Seconds of the day, CLOCK_START_UNSET = not set
+	char timeZone[TIME_ZONE_NAME_LENGTH];
+	int shaderQuality;
 };
 
 enum Argument
@@ -41,7 +57,14 @@ enum Argument
 
 	DISPLAY,
 	NO_SOUND,
-	NO_FADE_IN
+	NO_FADE_IN,
+	TRAILS,
+	TRAIL_BUDGET,
+	CLOCK,
+	CLOCK_RATE,
+	CLOCK_START,
+	TIME_ZONE,
+	QUALITY
 };
 
 struct CMDParameter
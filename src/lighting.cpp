@@ -0,0 +1,83 @@
+#include "lighting.h"
+#include "uniforms.h"
+
+#include <cstring>
+
+#if !defined(PLATFORM_WEB) && !defined(PLATFORM_ANDROID)
+    #define LIGHTING_UBO
+    #include "external/glad.h" // raylib's GL loader, uniform buffers have no rlgl wrapper
+#endif
+
+const unsigned int LIGHTING_BINDING = 0;
+
+static_assert(sizeof(LightingBlock) == LIGHTING_VECTORS * 4 * sizeof(float), "LightingBlock must be a whole number of vec4");
+
+// Bytes of the block up to the last light of the variant, the remaining lights are never read
+static int GetLightingSize(int pointLights)
+{
+    return (int)(sizeof(MaterialBlock) + sizeof(DirLightBlock) + pointLights * sizeof(PointLightBlock));
+}
+
+Lighting LoadLighting(Shader shader, int pointLights)
+{
+    Lighting lighting    = { 0 };
+    lighting.shader      = shader;
+    lighting.pointLights = pointLights < ORBS ? pointLights : ORBS;
+    lighting.location    = -1;
+
+#if defined(LIGHTING_UBO)
+    unsigned int blockIndex = glGetUniformBlockIndex(shader.id, "Lighting");
+    if (blockIndex == GL_INVALID_INDEX)
+    {
+        TraceLog(LOG_WARNING, "SHADER: [ID %i] Uniform block Lighting not found", shader.id);
+        return lighting;
+    }
+
+    int blockSize = 0;
+    glGetActiveUniformBlockiv(shader.id, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &blockSize);
+    if (blockSize != GetLightingSize(lighting.pointLights))
+        TraceLog(LOG_WARNING, "SHADER: [ID %i] Lighting block is %i bytes, expected %i", shader.id, blockSize, GetLightingSize(lighting.pointLights));
+
+    glUniformBlockBinding(shader.id, blockIndex, LIGHTING_BINDING);
+
+    glGenBuffers(1, &lighting.uboId);
+    glBindBuffer(GL_UNIFORM_BUFFER, lighting.uboId);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(LightingBlock), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, LIGHTING_BINDING, lighting.uboId);
+#else
+    lighting.location = GetShaderLocation(shader, "lighting");
+#endif
+
+    return lighting;
+}
+
+void UnloadLighting(Lighting lighting)
+{
+#if defined(LIGHTING_UBO)
+    if (lighting.uboId > 0)
+        glDeleteBuffers(1, &lighting.uboId);
+#endif
+}
+
+void UploadLighting(Lighting* lighting)
+{
+    bool changed = !lighting->valid || memcmp(&lighting->uploaded, &lighting->block, sizeof(LightingBlock)) != 0;
+    CountUniformUpload(changed);
+    if (!changed)
+        return;
+
+#if defined(LIGHTING_UBO)
+    if (lighting->uboId == 0)
+        return;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, lighting->uboId);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, GetLightingSize(lighting->pointLights), &lighting->block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+#else
+    SetShaderValueV(lighting->shader, lighting->location, &lighting->block, SHADER_UNIFORM_VEC4, GetLightingSize(lighting->pointLights) / (int)(4 * sizeof(float)));
+#endif
+
+    lighting->uploaded = lighting->block;
+    lighting->valid    = true;
+}
@@ -0,0 +1,68 @@
+#ifndef LIGHTING_H
+#define LIGHTING_H
+
+#include "raylib.h"
+#include "orbit.h"
+
+// Mirrors the std140 "Lighting" block of crystal.fs. Every member starts on a vec4
+// boundary, the GLSL 100 shader receives the same memory as a vec4 array.
+typedef struct
+{
+    Vector3 ambient;
+    float shininess;
+    Vector3 diffuse;
+    float padding0;
+    Vector3 specular;
+    float padding1;
+} MaterialBlock;
+
+typedef struct
+{
+    Vector3 direction;
+    float padding0;
+    Vector3 ambient;
+    float padding1;
+    Vector3 diffuse;
+    float padding2;
+    Vector3 specular;
+    float padding3;
+} DirLightBlock;
+
+typedef struct
+{
+    Vector3 position;
+    float constant;
+    Vector3 ambient;
+    float linear;
+    Vector3 diffuse;
+    float quadratic;
+    Vector3 specular;
+    float padding;
+} PointLightBlock;
+
+typedef struct
+{
+    MaterialBlock material;
+    DirLightBlock dirLight;
+    PointLightBlock pointLights[ORBS];
+} LightingBlock;
+
+const int LIGHTING_VECTORS = sizeof(LightingBlock) / (4 * sizeof(float));
+
+// Lighting uniforms of one shader, written on the CPU and uploaded with a single call
+typedef struct
+{
+    LightingBlock block;
+    LightingBlock uploaded; // Shadow copy, unchanged blocks are not uploaded again
+    bool valid;             // Shadow copy holds uploaded data
+    Shader shader;
+    int pointLights;    // Lights declared by the shader variant (NR_POINT_LIGHTS), only these are uploaded
+    unsigned int uboId; // Uniform buffer (GLSL 330), 0 when the vec4 array is used
+    int location;       // "lighting" vec4 array (GLSL 100)
+} Lighting;
+
+Lighting LoadLighting(Shader shader, int pointLights);
+void UnloadLighting(Lighting lighting);
+void UploadLighting(Lighting* lighting);
+
+#endif
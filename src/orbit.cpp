@@ -0,0 +1,123 @@
+#include "orbit.h"
+#include "raymath.h"
+
+#include <cmath>
+
+const float X_SPEED    = PI / 2;
+const float Z_SPEED    = -PI;
+const float ANGLE_STEP = 360.f / 60.f;
+const float ANGLES[]   = { PI / 2, PI + PI / 6, 0.f };
+
+float GetOrbRotationAngle(float time, int i)
+{
+    return time * i * ANGLE_STEP * DEG2RAD;
+}
+
+float GetClockRotationAngle(float hour)
+{
+    return hour < 12 ? hour * -30.0f : (hour - 12) * -30.0f;
+}
+
+float GetCurrentHourRotationAngle(const ElapsedSeconds& s)
+{
+    float elapsedHours = (float)fmod(s.day / 3600, 24);
+    return (90.f + GetClockRotationAngle(elapsedHours)) * DEG2RAD;
+}
+
+float LerpXRotationAngle(float secondsInMinute, int minute)
+{
+    // Minute may be negative after rolling back from the anchor
+    int keyframe = ((minute % 3) + 3) % 3;
+    return Lerp(ANGLES[keyframe], ANGLES[(keyframe + 1) % 3], Normalize(secondsInMinute, 0.f, 60.f));
+}
+
+OrbitAngles GetOrbitAngles(float secondsInMinute, int minute)
+{
+    OrbitAngles angles;
+    angles.x   = X_SPEED * secondsInMinute + LerpXRotationAngle(secondsInMinute, minute);
+    angles.z   = Z_SPEED * secondsInMinute;
+    angles.orb = GetOrbRotationAngle(secondsInMinute, 1);
+    return angles;
+}
+
+Matrix MatrixMultiplyRotation(const Matrix& left, const Matrix& right)
+{
+    Matrix result = MatrixIdentity();
+
+    result.m0  = left.m0*right.m0 + left.m1*right.m4 + left.m2*right.m8;
+    result.m1  = left.m0*right.m1 + left.m1*right.m5 + left.m2*right.m9;
+    result.m2  = left.m0*right.m2 + left.m1*right.m6 + left.m2*right.m10;
+    result.m4  = left.m4*right.m0 + left.m5*right.m4 + left.m6*right.m8;
+    result.m5  = left.m4*right.m1 + left.m5*right.m5 + left.m6*right.m9;
+    result.m6  = left.m4*right.m2 + left.m5*right.m6 + left.m6*right.m10;
+    result.m8  = left.m8*right.m0 + left.m9*right.m4 + left.m10*right.m8;
+    result.m9  = left.m8*right.m1 + left.m9*right.m5 + left.m10*right.m9;
+    result.m10 = left.m8*right.m2 + left.m9*right.m6 + left.m10*right.m10;
+
+    return result;
+}
+
+Matrix GetRotationMatrix(float secondsInMinute, int minute, float hourAngle)
+{
+    OrbitAngles angles = GetOrbitAngles(secondsInMinute, minute);
+
+    Matrix rx = MatrixRotateX(angles.x);
+    Matrix rz = MatrixRotateZ(angles.z);
+
+    return MatrixMultiplyRotation(MatrixMultiplyRotation(rz, rx), MatrixRotateZ(hourAngle));
+}
+
+Vector3 GetOrbPosition(float time, float radius, int orbIndex, const Matrix& rotation)
+{
+    float angle = GetOrbRotationAngle(time, orbIndex);
+    return Vector3Transform(
+            { radius * cosf(angle), radius * sinf(angle), 0.f },
+            rotation
+    );
+}
+
+void GetOrbitAnchor(OrbitAnchor* anchor, const ElapsedSeconds& s, const Time& t)
+{
+    anchor->secondsInMinute = s.minute;
+    anchor->minute          = t.minute;
+    anchor->hourAngle       = GetCurrentHourRotationAngle(s);
+}
+
+void GetOrbitTime(const OrbitAnchor& anchor, float offset, float* secondsInMinute, int* minute)
+{
+    float seconds = anchor.secondsInMinute - offset;
+    int   rollover = (int)floorf(seconds / 60.f);
+
+    *secondsInMinute = seconds - rollover * 60.f;
+    *minute          = anchor.minute + rollover;
+}
+
+Matrix SampleOrbitRotation(const OrbitAnchor& anchor, float offset)
+{
+    float seconds;
+    int minute;
+
+    GetOrbitTime(anchor, offset, &seconds, &minute);
+    return GetRotationMatrix(seconds, minute, anchor.hourAngle);
+}
+
+Vector3 SampleOrbPosition(const OrbitAnchor& anchor, float offset, float radius, int orbIndex)
+{
+    float seconds;
+    int minute;
+
+    GetOrbitTime(anchor, offset, &seconds, &minute);
+    return GetOrbPosition(seconds, radius, orbIndex, GetRotationMatrix(seconds, minute, anchor.hourAngle));
+}
+
+void SampleOrbPositions(const OrbitAnchor& anchor, float offset, float radius, Vector3* positions)
+{
+    float seconds;
+    int minute;
+
+    GetOrbitTime(anchor, offset, &seconds, &minute);
+    Matrix rotation = GetRotationMatrix(seconds, minute, anchor.hourAngle);
+
+    for (int i = 0; i < ORBS; i++)
+        positions[i] = GetOrbPosition(seconds, radius, i, rotation);
+}
@@ -0,0 +1,45 @@
+#ifndef ORBIT_H
+#define ORBIT_H
+
+#include "raylib.h"
+#include "timeinfo.h"
+
+const int ORBS = 7;
+
+// Orb kinematics reduced to the few values they actually depend on. Sampling the
+// orbit at any offset from the anchor is pure arithmetic, no local time conversion.
+typedef struct
+{
+    float secondsInMinute; // Seconds elapsed in the anchor minute
+    int   minute;          // Anchor minute, selects X-rotation keyframes
+    float hourAngle;       // Z-rotation of the current hour rod (radians)
+} OrbitAnchor;
+
+// Angles the orbit rotation is built from (radians)
+typedef struct
+{
+    float x;   // X-rotation of the orbit plane
+    float z;   // Z-rotation within the orbit plane
+    float orb; // Spacing between neighbouring orbs
+} OrbitAngles;
+
+float GetOrbRotationAngle(float time, int i);
+float GetClockRotationAngle(float hour);
+float GetCurrentHourRotationAngle(const ElapsedSeconds& s);
+float LerpXRotationAngle(float secondsInMinute, int minute);
+
+OrbitAngles GetOrbitAngles(float secondsInMinute, int minute);
+// Same operand order as MatrixMultiply (left is applied first), 3x3 part only
+Matrix MatrixMultiplyRotation(const Matrix& left, const Matrix& right);
+Matrix GetRotationMatrix(float secondsInMinute, int minute, float hourAngle);
+Vector3 GetOrbPosition(float time, float radius, int orbIndex, const Matrix& rotation);
+
+void GetOrbitAnchor(OrbitAnchor* anchor, const ElapsedSeconds& s, const Time& t);
+void GetOrbitTime(const OrbitAnchor& anchor, float offset, float* secondsInMinute, int* minute);
+
+// Offset is in seconds, positive values sample the past
+Matrix SampleOrbitRotation(const OrbitAnchor& anchor, float offset);
+Vector3 SampleOrbPosition(const OrbitAnchor& anchor, float offset, float radius, int orbIndex);
+void SampleOrbPositions(const OrbitAnchor& anchor, float offset, float radius, Vector3* positions);
+
+#endif
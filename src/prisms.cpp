@@ -0,0 +1,155 @@
+#include "prisms.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <cstddef>
+
+#if !defined(PLATFORM_WEB) && !defined(PLATFORM_ANDROID)
+    #define PRISM_INSTANCING
+#endif
+
+#if defined(PRISM_INSTANCING)
+static void BindPrismInstanceAttributes(const PrismBatch& batch)
+{
+    Shader shader = batch.model.materials[0].shader;
+    int modelLoc  = GetShaderLocationAttrib(shader, "instanceModel");
+    int normalLoc = GetShaderLocationAttrib(shader, "instanceNormal");
+    int scaleLoc  = GetShaderLocationAttrib(shader, "instanceScale");
+    int stride    = sizeof(PrismInstance);
+
+    rlEnableVertexBuffer(batch.instanceVboId);
+
+    // Matrix attributes take one location per column
+    for (int column = 0; modelLoc >= 0 && column < 4; column++)
+    {
+        rlSetVertexAttribute(modelLoc + column, 4, RL_FLOAT, false, stride, offsetof(PrismInstance, model) + column * 4 * sizeof(float));
+        rlEnableVertexAttribute(modelLoc + column);
+        rlSetVertexAttributeDivisor(modelLoc + column, 1);
+    }
+
+    for (int column = 0; normalLoc >= 0 && column < 3; column++)
+    {
+        rlSetVertexAttribute(normalLoc + column, 3, RL_FLOAT, false, stride, offsetof(PrismInstance, normal) + column * 3 * sizeof(float));
+        rlEnableVertexAttribute(normalLoc + column);
+        rlSetVertexAttributeDivisor(normalLoc + column, 1);
+    }
+
+    if (scaleLoc >= 0)
+    {
+        rlSetVertexAttribute(scaleLoc, 1, RL_FLOAT, false, stride, offsetof(PrismInstance, scale));
+        rlEnableVertexAttribute(scaleLoc);
+        rlSetVertexAttributeDivisor(scaleLoc, 1);
+    }
+}
+#endif
+
+PrismBatch LoadPrismBatch(Model model)
+{
+    PrismBatch batch = { 0 };
+    batch.model = model;
+
+    Shader shader = model.materials[0].shader;
+    batch.offset  = GetUniformVec3(shader, "prismOffset");
+
+    for (int i = 0; i < PRISM_INSTANCES; i++)
+        SetPrismTransform(&batch, i, MatrixIdentity(), MatrixIdentity(), 1.f);
+
+#if defined(PRISM_INSTANCING)
+    // Instance attributes are added to the mesh VAO, raylib's own draws never use them
+    batch.instanceVboId = rlLoadVertexBuffer(batch.instances, sizeof(batch.instances), true);
+    if (rlEnableVertexArray(model.meshes[0].vaoId))
+    {
+        BindPrismInstanceAttributes(batch);
+        rlDisableVertexArray();
+    }
+    rlDisableVertexBuffer();
+#else
+    batch.modelUniform  = GetUniformMatrix(shader, "model");
+    batch.normalUniform = GetUniformMatrix(shader, "mNormal");
+#endif
+
+    return batch;
+}
+
+void UnloadPrismBatch(PrismBatch batch)
+{
+    if (batch.instanceVboId > 0)
+        rlUnloadVertexBuffer(batch.instanceVboId);
+}
+
+void SetPrismTransform(PrismBatch* batch, int instance, const Matrix& model, const Matrix& normal, float scale)
+{
+    PrismInstance& data = batch->instances[instance];
+    float16 m = MatrixToFloatV(model);
+    float16 n = MatrixToFloatV(normal);
+
+    for (int i = 0; i < 16; i++)
+        data.model[i] = m.v[i];
+
+    for (int column = 0; column < 3; column++)
+        for (int row = 0; row < 3; row++)
+            data.normal[column * 3 + row] = n.v[column * 4 + row];
+
+    data.scale = scale;
+    batch->models[instance]  = model;
+    batch->normals[instance] = normal;
+}
+
+#if defined(PRISM_INSTANCING)
+void DrawPrismBatch(PrismBatch* batch, Vector3 position)
+{
+    Mesh& mesh         = batch->model.meshes[0];
+    Material& material = batch->model.materials[0];
+
+    rlEnableShader(material.shader.id);
+    SetUniform(&batch->offset, position);
+
+    // Modelview holds only the camera view, instances bring their own transform
+    Matrix viewProjection = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    rlSetUniformMatrix(material.shader.locs[SHADER_LOC_MATRIX_MVP], viewProjection);
+
+    rlActiveTextureSlot(MATERIAL_MAP_NORMAL);
+    rlEnableTexture(material.maps[MATERIAL_MAP_NORMAL].texture.id);
+
+    rlUpdateVertexBuffer(batch->instanceVboId, batch->instances, sizeof(batch->instances), 0);
+
+    rlEnableVertexArray(mesh.vaoId);
+    if (mesh.indices != NULL)
+        rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, 0, PRISM_INSTANCES);
+    else
+        rlDrawVertexArrayInstanced(0, mesh.vertexCount, PRISM_INSTANCES);
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlActiveTextureSlot(0);
+    rlDisableShader();
+}
+#else
+void DrawPrismBatch(PrismBatch* batch, Vector3 position)
+{
+    Model& model = batch->model;
+
+    // Hour rod first and without depth writes, so it never hides the prisms
+    for (int n = 0; n < PRISM_INSTANCES; n++)
+    {
+        int i = (n + PRISM_HOUR_ROD) % PRISM_INSTANCES;
+        rlPushMatrix();
+        rlMultMatrixf(MatrixToFloat(batch->models[i]));
+        SetUniform(&batch->modelUniform,  batch->models[i]);
+        SetUniform(&batch->normalUniform, batch->normals[i]);
+
+        if (i == PRISM_HOUR_ROD)
+        {
+            rlDisableDepthMask();
+            DrawModelEx(model, position, { 0.f, 0.f, 0.f }, 0.f, { 1.f, batch->instances[i].scale, 1.f }, WHITE);
+            rlEnableDepthMask();
+        }
+        else
+        {
+            DrawModel(model, position, 1.f, WHITE);
+        }
+
+        rlPopMatrix();
+    }
+}
+#endif
@@ -0,0 +1,40 @@
+#ifndef PRISMS_H
+#define PRISMS_H
+
+#include "raylib.h"
+#include "uniforms.h"
+
+const int PRISMS          = 12;
+const int PRISM_HOUR_ROD  = PRISMS;     // Extra instance, scaled copy of the current hour prism
+const int PRISM_INSTANCES = PRISMS + 1;
+
+// Per-instance data read by crystal.vs as vertex attributes
+typedef struct
+{
+    float model[16];  // Column-major
+    float normal[9];  // Column-major 3x3
+    float scale;      // Y-scale
+} PrismInstance;
+
+// All crystal prisms of the clock. GLSL 330 draws every instance with one instanced
+// draw call, GLSL 100 has no instancing and falls back to one draw per prism.
+typedef struct
+{
+    Model model;
+    PrismInstance instances[PRISM_INSTANCES];
+    Matrix models[PRISM_INSTANCES];  // Same transforms as uniforms for the per-prism fallback
+    Matrix normals[PRISM_INSTANCES];
+
+    unsigned int instanceVboId;
+    UniformVec3 offset;   // Prism position, applied before the instance transform
+    UniformMatrix modelUniform;
+    UniformMatrix normalUniform;
+} PrismBatch;
+
+PrismBatch LoadPrismBatch(Model model);
+void UnloadPrismBatch(PrismBatch batch);
+
+void SetPrismTransform(PrismBatch* batch, int instance, const Matrix& model, const Matrix& normal, float scale);
+void DrawPrismBatch(PrismBatch* batch, Vector3 position);
+
+#endif
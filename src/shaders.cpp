@@ -0,0 +1,261 @@
+#include "shaders.h"
+#include "rlgl.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#if defined(PLATFORM_WEB) || defined(PLATFORM_ANDROID)
+    #define GLSL_VERSION 100
+#else
+    #define GLSL_VERSION 330
+#endif
+
+// Linked programs are cached where the driver can return them, WebGL has no program binaries
+#if defined(PLATFORM_ANDROID)
+    #define SHADER_CACHE
+    #include <EGL/egl.h>
+    #include <GLES2/gl2.h>
+    #include <GLES2/gl2ext.h>
+
+    #define GL_PROGRAM_BINARY_LENGTH      GL_PROGRAM_BINARY_LENGTH_OES
+    #define GL_NUM_PROGRAM_BINARY_FORMATS GL_NUM_PROGRAM_BINARY_FORMATS_OES
+
+typedef PFNGLGETPROGRAMBINARYOESPROC GetProgramBinaryProc;
+typedef PFNGLPROGRAMBINARYOESPROC ProgramBinaryProc;
+#elif !defined(PLATFORM_WEB)
+    #define SHADER_CACHE
+    #include "external/glad.h" // raylib's GL loader from its source tree, program binaries have no rlgl wrapper
+
+typedef PFNGLGETPROGRAMBINARYPROC GetProgramBinaryProc;
+typedef PFNGLPROGRAMBINARYPROC ProgramBinaryProc;
+#endif
+
+// Maps the GLSL 100 keywords used by the sources to the platform dialect
+#if GLSL_VERSION == 330
+const char* VERTEX_DIALECT   = "#define attribute in\n"
+                               "#define varying out\n";
+const char* FRAGMENT_DIALECT = "#define varying in\n"
+                               "#define texture2D texture\n"
+                               "out vec4 finalColor;\n";
+#else
+const char* VERTEX_DIALECT   = "";
+const char* FRAGMENT_DIALECT = "#extension GL_OES_standard_derivatives : enable\n" // dFdx/dFdy of the SDF text
+                               "precision mediump float;\n"
+                               "#define finalColor gl_FragColor\n";
+#endif
+
+static string BuildShaderSource(const char* fileName, const char* dialect, const char* defines)
+{
+    char* text = LoadFileText(fileName);
+    if (!text)
+        return string();
+
+    string source = "#version " + to_string(GLSL_VERSION) + "\n";
+    source += "#define GLSL_VERSION " + to_string(GLSL_VERSION) + "\n";
+    source += dialect;
+    source += defines ? defines : "";
+
+    // Compiler messages keep the line numbers of the file
+    source += "#line 1\n";
+    source += text;
+
+    UnloadFileText(text);
+    return source;
+}
+
+#if defined(SHADER_CACHE)
+const unsigned int PROGRAM_BINARY_MAGIC = 0x42504343; // "CCPB"
+
+// Header of a cache file, followed by the driver's program binary
+typedef struct
+{
+    unsigned int magic;
+    unsigned int format; // Driver specific binary format
+    int length;          // Binary size (bytes)
+} ProgramBinaryHeader;
+
+string shaderCacheDirectory;
+
+GetProgramBinaryProc getProgramBinary = NULL;
+ProgramBinaryProc programBinary       = NULL;
+bool programBinaryChecked             = false;
+
+static bool IsProgramBinarySupported()
+{
+    if (programBinaryChecked)
+        return getProgramBinary && programBinary;
+
+    programBinaryChecked = true;
+
+#if defined(PLATFORM_ANDROID)
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    if (extensions && strstr(extensions, "GL_OES_get_program_binary"))
+    {
+        getProgramBinary = (GetProgramBinaryProc)eglGetProcAddress("glGetProgramBinaryOES");
+        programBinary    = (ProgramBinaryProc)eglGetProcAddress("glProgramBinaryOES");
+    }
+#else
+    // Core since GL 4.1, glad leaves the pointers empty on older contexts without ARB_get_program_binary
+    getProgramBinary = glGetProgramBinary;
+    programBinary    = glProgramBinary;
+#endif
+
+    // Drivers may expose the entry points without supporting any binary format
+    int formats = 0;
+    if (getProgramBinary && programBinary)
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+    if (formats <= 0)
+    {
+        getProgramBinary = NULL;
+        programBinary    = NULL;
+    }
+
+    return getProgramBinary && programBinary;
+}
+
+// Sources and driver identification, a driver update or an edited shader never hits a stale binary.
+// An empty source is raylib's built-in default stage, which only the raylib version identifies.
+static string GetProgramCachePath(const string& vsSource, const string& fsSource)
+{
+    string key = "raylib " RAYLIB_VERSION + string(1, '\0');
+    key += vsSource + '\0' + fsSource + '\0';
+    key += (const char*)glGetString(GL_VENDOR) + string(1, '\0');
+    key += (const char*)glGetString(GL_RENDERER) + string(1, '\0');
+    key += (const char*)glGetString(GL_VERSION);
+
+    unsigned int* hash = ComputeSHA1((unsigned char*)&key[0], (int)key.size());
+    return shaderCacheDirectory + TextFormat("/%08x%08x%08x%08x%08x.bin", hash[0], hash[1], hash[2], hash[3], hash[4]);
+}
+
+static unsigned int LoadCachedProgram(const string& path)
+{
+    ifstream ifs(path, ios::binary);
+    if (!ifs.is_open())
+        return 0;
+
+    vector<char> data((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+
+    ProgramBinaryHeader header;
+    if (data.size() < sizeof(header))
+        return 0;
+
+    memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != PROGRAM_BINARY_MAGIC || header.length <= 0 || data.size() != sizeof(header) + header.length)
+        return 0;
+
+    unsigned int id = glCreateProgram();
+    programBinary(id, header.format, data.data() + sizeof(header), header.length);
+
+    // Binaries are rejected after driver changes that keep the version string
+    int linked = GL_FALSE;
+    glGetProgramiv(id, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        glDeleteProgram(id);
+        return 0;
+    }
+
+    return id;
+}
+
+static void SaveCachedProgram(const string& path, unsigned int id)
+{
+    int length = 0;
+    glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    ProgramBinaryHeader header = { PROGRAM_BINARY_MAGIC, 0, 0 };
+    vector<char> binary(length);
+    getProgramBinary(id, length, &header.length, &header.format, binary.data());
+    if (header.length <= 0)
+        return;
+
+    MakeDirectory(shaderCacheDirectory.c_str());
+
+    ofstream ofs(path, ios::binary | ios::trunc);
+    if (!ofs.is_open())
+        return;
+
+    ofs.write((const char*)&header, sizeof(header));
+    ofs.write(binary.data(), header.length);
+}
+
+// Same default locations LoadShaderFromMemory() resolves after linking
+static Shader LoadShaderFromProgram(unsigned int id)
+{
+    Shader shader = { 0 };
+    shader.id     = id;
+    shader.locs   = (int*)MemAlloc(RL_MAX_SHADER_LOCATIONS * sizeof(int));
+
+    for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; i++)
+        shader.locs[i] = -1;
+
+    shader.locs[SHADER_LOC_VERTEX_POSITION]    = rlGetLocationAttrib(id, "vertexPosition");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD01]  = rlGetLocationAttrib(id, "vertexTexCoord");
+    shader.locs[SHADER_LOC_VERTEX_TEXCOORD02]  = rlGetLocationAttrib(id, "vertexTexCoord2");
+    shader.locs[SHADER_LOC_VERTEX_NORMAL]      = rlGetLocationAttrib(id, "vertexNormal");
+    shader.locs[SHADER_LOC_VERTEX_TANGENT]     = rlGetLocationAttrib(id, "vertexTangent");
+    shader.locs[SHADER_LOC_VERTEX_COLOR]       = rlGetLocationAttrib(id, "vertexColor");
+    shader.locs[SHADER_LOC_VERTEX_BONEIDS]     = rlGetLocationAttrib(id, "vertexBoneIds");
+    shader.locs[SHADER_LOC_VERTEX_BONEWEIGHTS] = rlGetLocationAttrib(id, "vertexBoneWeights");
+
+    shader.locs[SHADER_LOC_MATRIX_MVP]        = rlGetLocationUniform(id, "mvp");
+    shader.locs[SHADER_LOC_MATRIX_VIEW]       = rlGetLocationUniform(id, "matView");
+    shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(id, "matProjection");
+    shader.locs[SHADER_LOC_MATRIX_MODEL]      = rlGetLocationUniform(id, "matModel");
+    shader.locs[SHADER_LOC_MATRIX_NORMAL]     = rlGetLocationUniform(id, "matNormal");
+    shader.locs[SHADER_LOC_BONE_MATRICES]     = rlGetLocationUniform(id, "boneMatrices");
+
+    shader.locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(id, "colDiffuse");
+    shader.locs[SHADER_LOC_MAP_DIFFUSE]   = rlGetLocationUniform(id, "texture0");
+    shader.locs[SHADER_LOC_MAP_SPECULAR]  = rlGetLocationUniform(id, "texture1");
+    shader.locs[SHADER_LOC_MAP_NORMAL]    = rlGetLocationUniform(id, "texture2");
+
+    return shader;
+}
+#endif
+
+void SetShaderCacheDirectory(const char* directory)
+{
+#if defined(SHADER_CACHE)
+    shaderCacheDirectory = directory ? directory : "";
+#endif
+}
+
+Shader LoadShaderVariant(const char* vsFileName, const char* fsFileName, const char* defines)
+{
+    string vsSource = vsFileName ? BuildShaderSource(vsFileName, VERTEX_DIALECT, defines) : string();
+    string fsSource = fsFileName ? BuildShaderSource(fsFileName, FRAGMENT_DIALECT, defines) : string();
+
+#if defined(SHADER_CACHE)
+    string cachePath;
+    if (!shaderCacheDirectory.empty() && IsProgramBinarySupported())
+    {
+        cachePath = GetProgramCachePath(vsSource, fsSource);
+
+        unsigned int id = LoadCachedProgram(cachePath);
+        if (id > 0)
+        {
+            TraceLog(LOG_INFO, "SHADER: [ID %i] Program loaded from cache %s", id, cachePath.c_str());
+            return LoadShaderFromProgram(id);
+        }
+    }
+#endif
+
+    Shader shader = LoadShaderFromMemory(vsSource.empty() ? NULL : vsSource.c_str(), fsSource.empty() ? NULL : fsSource.c_str());
+
+#if defined(SHADER_CACHE)
+    // Failed compiles fall back to raylib's default shader, which is never cached
+    if (!cachePath.empty() && shader.id > 0 && shader.id != rlGetShaderIdDefault())
+        SaveCachedProgram(cachePath, shader.id);
+#endif
+
+    return shader;
+}
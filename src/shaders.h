@@ -0,0 +1,24 @@
+#ifndef SHADERS_H
+#define SHADERS_H
+
+#include "raylib.h"
+
+// Feature set of the crystal shader variant
+enum ShaderQuality
+{
+    SHADER_QUALITY_HIGH,   // All point lights, normal map and rim light
+    SHADER_QUALITY_MEDIUM, // Interpolated normals instead of the normal map
+    SHADER_QUALITY_LOW     // First three point lights only, no normal map, no rim light
+};
+
+// Compiles one shader variant from the single-source files in resources/shaders.
+// Sources are written in the GLSL 100 dialect and output to finalColor. A version line,
+// GLSL_VERSION, the dialect mapping of the platform and the given defines ("#define NAME 1\n"...)
+// are prepended before compiling. Either file may be NULL to use raylib's default stage.
+// Linked programs are cached in the directory when the driver supports program binaries and
+// reloaded on the next launch, keyed by the generated sources and the GL vendor, renderer and
+// version. Misses and rejected binaries compile from source. Empty directory disables the cache.
+Shader LoadShaderVariant(const char* vsFileName, const char* fsFileName, const char* defines);
+void SetShaderCacheDirectory(const char* directory);
+
+#endif
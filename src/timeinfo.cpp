@@ -1,51 +1,78 @@
 #include "timeinfo.h"
-#include <iomanip>
-#include <sstream>
+#include <cmath>
+#include <ctime>
 
 using namespace std;
 
+double GetSecondFraction(Time t)
+{
+    return t.microsecond / 1000000.0;
+}
+
 float GetElapsedSecondsMinute(Time t) 
 {
-    return t.second + (t.millisecond / 1000.f);
+    return (float)(t.second + GetSecondFraction(t));
 }
 
 float GetElapsedSecondsHour(Time t) 
 {
-    return t.minute * 60.f + GetElapsedSecondsMinute(t);
+    return (float)(t.minute * 60.0 + t.second + GetSecondFraction(t));
 }
 
 float GetElapsedSecondsDay(Time t) 
 {
-    return t.hour * 3600.f + GetElapsedSecondsHour(t);
+    return (float)(t.hour * 3600.0 + t.minute * 60.0 + t.second + GetSecondFraction(t));
 }
 
 void GetElapsedSeconds(ElapsedSeconds* s, Time t) 
 {
-    s->minute = t.second + (t.millisecond / 1000.f);
-    s->hour   = t.minute * 60.f + s->minute;
-    s->day    = t.hour * 3600.f + s->hour;
+    s->minute = GetElapsedSecondsMinute(t);
+    s->hour   = GetElapsedSecondsHour(t);
+    s->day    = GetElapsedSecondsDay(t);
 }
 
+const double CLOCK_FIXED_STEP = 1.0 / 60.0;
+const double CLOCK_WARP_SCALE = 60.0;
+const double CLOCK_MAX_DRIFT  = 0.25; // Wall time step beyond the frame time that counts as a jump (seconds)
+
+static int clockMode       = CLOCK_MODE_REAL;
+static double clockRate    = 1.0;
+static TimePoint clockNow  = chrono::system_clock::now();
+static double clockDelta   = 0.0;
+static double clockElapsed = 0.0;
+static bool clockRestarted = true;
+static bool clockJumped    = false;
+
+// Broken-down local time of the current local minute. UTC offsets only change at
+// whole minutes, so queries inside that minute are answered without libc.
+static bool localMinuteValid = false;
+static time_t localMinuteStart;
+static tm localMinute;
+
 void GetLocalTime(Time* timeInfo, TimePoint now)
 {
     time_t now_time_t = chrono::system_clock::to_time_t(now);
-    tm local_time;
 
+    if (!localMinuteValid || now_time_t < localMinuteStart || now_time_t >= localMinuteStart + 60)
+    {
 #ifdef _WIN32
-    localtime_s(&local_time, &now_time_t);
+        localtime_s(&localMinute, &now_time_t);
 #else
-    localtime_r(&now_time_t, &local_time);
+        localtime_r(&now_time_t, &localMinute);
 #endif
+        localMinuteStart = now_time_t - localMinute.tm_sec;
+        localMinuteValid = true;
+    }
 
-    int year   = local_time.tm_year;
-    int month  = local_time.tm_mon;
-    int day    = local_time.tm_mday;
-    int hour   = local_time.tm_hour;
-    int minute = local_time.tm_min;
-    int second = local_time.tm_sec;
+    int year   = localMinute.tm_year;
+    int month  = localMinute.tm_mon;
+    int day    = localMinute.tm_mday;
+    int hour   = localMinute.tm_hour;
+    int minute = localMinute.tm_min;
+    int second = (int)(now_time_t - localMinuteStart);
 
     auto epoch_time = now.time_since_epoch();
-    int millisecond = chrono::duration_cast<chrono::milliseconds>(epoch_time).count() % 1000;
+    int microsecond = (int)(chrono::duration_cast<Duration>(epoch_time).count() % 1000000);
 
     timeInfo->timePoint   = now;
     timeInfo->year        = year;
@@ -55,7 +82,8 @@ void GetLocalTime(Time* timeInfo, TimePoint now)
     timeInfo->hour        = hour;
     timeInfo->minute      = minute;
     timeInfo->second      = second;
-    timeInfo->millisecond = millisecond;
+    timeInfo->millisecond = microsecond / 1000;
+    timeInfo->microsecond = microsecond;
 }
 
 void GetTimeInfo(Time* timeInfo, TimePoint now)
@@ -65,34 +93,172 @@ void GetTimeInfo(Time* timeInfo, TimePoint now)
 
 void GetTimeInfo(Time* timeInfo) 
 {
-    GetLocalTime(timeInfo, chrono::system_clock::now());
+    GetLocalTime(timeInfo, clockNow);
+}
+
+void GetTimeInfo(Time* timeInfo, TimePoint now, const TimeZone& zone)
+{
+    long long microseconds = chrono::duration_cast<Duration>(now.time_since_epoch()).count();
+    long long seconds      = microseconds / 1000000 - (microseconds % 1000000 < 0 ? 1 : 0);
+    long long local        = seconds + GetTimeZoneOffset(zone, seconds);
+    long long days         = local / 86400 - (local % 86400 < 0 ? 1 : 0);
+    int secondOfDay        = (int)(local - days * 86400);
+
+    long long year;
+    int month;
+    int day;
+    CivilFromDays(days, &year, &month, &day);
+
+    timeInfo->timePoint   = now;
+    timeInfo->year        = (int)(year - 1900);
+    timeInfo->month       = month - 1;
+    timeInfo->day         = day;
+
+    timeInfo->hour        = secondOfDay / 3600;
+    timeInfo->minute      = secondOfDay / 60 % 60;
+    timeInfo->second      = secondOfDay % 60;
+    timeInfo->microsecond = (int)(microseconds - seconds * 1000000);
+    timeInfo->millisecond = timeInfo->microsecond / 1000;
+}
+
+void GetTimeInfo(Time* timeInfo, const TimeZone& zone)
+{
+    GetTimeInfo(timeInfo, clockNow, zone);
+}
+
+static TimePoint GetClockStart(TimePoint now, int startSeconds, const TimeZone* zone)
+{
+    if (zone)
+    {
+        Time today;
+        GetTimeInfo(&today, now, *zone);
+
+        // Offset at the wall time itself, refined once so starts next to a transition land on the right side
+        long long local = DaysFromCivil(today.year + 1900, today.month + 1, today.day) * 86400 + startSeconds;
+        long long utc   = local - GetTimeZoneOffset(*zone, local);
+        utc = local - GetTimeZoneOffset(*zone, utc);
+
+        return chrono::system_clock::from_time_t((time_t)utc);
+    }
+
+    Time today;
+    GetLocalTime(&today, now);
+
+    tm start = { 0 };
+    start.tm_year  = today.year;
+    start.tm_mon   = today.month;
+    start.tm_mday  = today.day;
+    start.tm_hour  = startSeconds / 3600;
+    start.tm_min   = startSeconds / 60 % 60;
+    start.tm_sec   = startSeconds % 60;
+    start.tm_isdst = -1;
+
+    return chrono::system_clock::from_time_t(mktime(&start));
+}
+
+void InitClockSource(int mode, double rate, int startSeconds, const TimeZone* zone)
+{
+    clockMode    = mode;
+    clockNow     = chrono::system_clock::now();
+    clockDelta   = 0.0;
+    clockElapsed = 0.0;
+
+    clockRestarted = true;
+
+    if (mode == CLOCK_MODE_FIXED)
+        clockRate = rate > 0.0 ? rate : CLOCK_FIXED_STEP;
+    else if (mode == CLOCK_MODE_WARP)
+        clockRate = rate > 0.0 ? rate : CLOCK_WARP_SCALE;
+    else
+        clockRate = 1.0;
+
+    if (mode != CLOCK_MODE_REAL && startSeconds != CLOCK_START_UNSET)
+        clockNow = GetClockStart(clockNow, startSeconds, zone);
+}
+
+void TickClockSource(double realTime, double realDelta)
+{
+    clockJumped    = clockRestarted;
+    clockRestarted = false;
+
+    switch (clockMode)
+    {
+    case CLOCK_MODE_FIXED:
+        clockDelta = clockRate;
+        break;
+    case CLOCK_MODE_WARP:
+        clockDelta = realDelta * clockRate;
+        break;
+    default:
+    {
+        // Suspend/resume and system clock changes move the wall time but not the frame time
+        TimePoint now = chrono::system_clock::now();
+        clockJumped   = clockJumped || fabs(chrono::duration<double>(now - clockNow).count() - realDelta) > CLOCK_MAX_DRIFT;
+
+        clockNow     = now;
+        clockDelta   = realDelta;
+        clockElapsed = realTime;
+        return;
+    }
+    }
+
+    clockNow += chrono::duration_cast<chrono::system_clock::duration>(chrono::duration<double>(clockDelta));
+    clockElapsed += clockDelta;
+}
+
+double GetClockDeltaTime()
+{
+    return clockDelta;
 }
 
-string PutTime(const tm& localTime, const char* timeLocale, const char* format)
+double GetClockElapsedTime()
 {
-    ostringstream oss;
-    oss.imbue(std::locale(timeLocale));
-    oss << put_time(&localTime, format);
+    return clockElapsed;
+}
 
-    return oss.str();
+bool IsClockJumped()
+{
+    return clockJumped;
 }
 
-string FormatDate(const Time& time, const char* timeLocale)
+void ResetTimeText(TimeText* text)
 {
-    tm localTime;
-    localTime.tm_year = time.year;
-    localTime.tm_mon  = time.month;
-    localTime.tm_mday = time.day;
-    
-    return PutTime(localTime, timeLocale, "%x");
+    text->date[0] = '\0';
+    text->time[0] = '\0';
+    text->dateKey = -1;
+    text->timeKey = -1;
 }
 
-string FormatTime(const Time& time, const char* timeLocale)
+// Returns true when any of the texts changed
+bool UpdateTimeText(TimeText* text, const Time& time)
 {
-    tm localTime;
-    localTime.tm_hour = time.hour;
-    localTime.tm_min  = time.minute;
-    localTime.tm_sec  = time.second;
+    int dateKey = (time.year * 12 + time.month) * 31 + time.day;
+    int timeKey = time.hour * 3600 + time.minute * 60 + time.second;
 
-    return PutTime(localTime, timeLocale, "%X");
-}
\ No newline at end of file
+    bool changed = false;
+    tm localTime = { 0 };
+
+    if (dateKey != text->dateKey)
+    {
+        localTime.tm_year = time.year;
+        localTime.tm_mon  = time.month;
+        localTime.tm_mday = time.day;
+
+        strftime(text->date, TIME_TEXT_LENGTH, "%x", &localTime);
+        text->dateKey = dateKey;
+        changed = true;
+    }
+
+    if (timeKey != text->timeKey)
+    {
+        localTime.tm_hour = time.hour;
+        localTime.tm_min  = time.minute;
+        localTime.tm_sec  = time.second;
+
+        strftime(text->time, TIME_TEXT_LENGTH, "%X", &localTime);
+        text->timeKey = timeKey;
+        changed = true;
+    }
+
+    return changed;
+}
@@ -1,12 +1,14 @@
 #ifndef TIMEINFO_H
 #define TIMEINFO_H
 
+#include "timezone.h"
+
 #include <chrono>
 #include <string>
 
 using namespace std;
 using TimePoint = chrono::system_clock::time_point;
-using Duration  = chrono::milliseconds;
+using Duration  = chrono::microseconds;
 
 typedef struct 
 {
@@ -19,6 +21,7 @@ typedef struct
     int minute;
     int second;
     int millisecond;
+    int microsecond; // Fraction of the second, 0 - 999999
 } Time;
 
 typedef struct 
@@ -28,15 +31,55 @@ typedef struct
     float day;
 } ElapsedSeconds;
 
+enum ClockMode
+{
+    CLOCK_MODE_REAL,  // System clock
+    CLOCK_MODE_FIXED, // Virtual time advanced by a fixed step every tick
+    CLOCK_MODE_WARP   // Virtual time advanced by real frame time times a scale
+};
+
+const int CLOCK_START_UNSET = -1; // No start time of day, virtual time starts from now
+
+const int TIME_TEXT_LENGTH = 64;
+
+// Date and time in the LC_TIME locale, formatted again only when the shown value changes
+typedef struct
+{
+    char date[TIME_TEXT_LENGTH];
+    char time[TIME_TEXT_LENGTH];
+
+    int dateKey; // Day the date text shows, -1 before the first update
+    int timeKey; // Second of the day the time text shows
+} TimeText;
+
+// Computed in double from the microsecond field, accurate to the microsecond
+double GetSecondFraction(Time t);
 float GetElapsedSecondsMinute(Time t);
 float GetElapsedSecondsHour(Time t);
 float GetElapsedSecondsDay(Time t);
 
 void GetElapsedSeconds(ElapsedSeconds* s, Time t);
+
+// Time source behind GetTimeInfo(Time*). Rate is the step in seconds for the fixed
+// mode and the time scale for warp, 0 picks the default. A start in seconds of the
+// day moves virtual time to that wall time today in the zone, or in the process TZ
+// when zone is NULL.
+void InitClockSource(int mode, double rate, int startSeconds, const TimeZone* zone);
+void TickClockSource(double realTime, double realDelta);
+double GetClockDeltaTime();
+double GetClockElapsedTime();
+// The last tick did not continue from the one before: a (re)started source, suspend/resume
+// or a system clock change. Virtual modes only jump when started.
+bool IsClockJumped();
+
 void GetTimeInfo(Time* timeInfo);
 void GetTimeInfo(Time* timeInfo, TimePoint timePoint);
 
-string FormatDate(const Time& time, const char* timeLocale);
-string FormatTime(const Time& time, const char* timeLocale);
+// Local time of the given zone instead of the process TZ, a table lookup without libc
+void GetTimeInfo(Time* timeInfo, const TimeZone& zone);
+void GetTimeInfo(Time* timeInfo, TimePoint timePoint, const TimeZone& zone);
+
+void ResetTimeText(TimeText* text);
+bool UpdateTimeText(TimeText* text, const Time& time);
 
 #endif
@@ -0,0 +1,355 @@
+#include "timezone.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+const char* ZONEINFO_DIRECTORY = "/usr/share/zoneinfo";
+
+const int TZIF_HEADER_SIZE = 44;
+const int DEFAULT_RULE_TIME = 2 * 3600;
+
+// Day of a POSIX TZ rule: Jn (1-365, no leap day), n (0-365) or Mm.w.d
+typedef struct
+{
+    char kind;   // 'J', 'N' or 'M'
+    int day;     // Day for J/N, weekday (0 = Sunday) for M
+    int week;    // 1-5, 5 = last
+    int month;   // 1-12
+    int time;    // Local time of the transition (seconds)
+} TimeZoneDate;
+
+// POSIX TZ string from the TZif footer, describes offsets after the last transition
+typedef struct
+{
+    int stdOffset;
+    int dstOffset;
+    bool dst;
+    TimeZoneDate start;
+    TimeZoneDate end;
+} TimeZoneRule;
+
+static long long ReadBigEndian(const unsigned char* data, int size)
+{
+    unsigned long long value = 0;
+    for (int i = 0; i < size; i++)
+        value = (value << 8) | data[i];
+
+    // Sign extend 32-bit values
+    if (size == 4)
+        return (long long)(int)(unsigned int)value;
+
+    return (long long)value;
+}
+
+static bool IsLeapYear(long long year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static const char* ParseZoneName(const char* p)
+{
+    if (*p == '<')
+    {
+        while (*p && *p != '>')
+            p++;
+        return *p ? p + 1 : nullptr;
+    }
+
+    const char* begin = p;
+    while ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z'))
+        p++;
+
+    return p - begin >= 3 ? p : nullptr;
+}
+
+// [+-]hh[:mm[:ss]]
+static const char* ParseZoneSeconds(const char* p, int* seconds)
+{
+    int sign = 1;
+    if (*p == '+' || *p == '-')
+        sign = *p++ == '-' ? -1 : 1;
+
+    int fields[3] = { 0, 0, 0 };
+    for (int i = 0; i < 3; i++)
+    {
+        if (*p < '0' || *p > '9')
+            return i == 0 ? nullptr : p;
+
+        char* end;
+        fields[i] = (int)strtol(p, &end, 10);
+        p = end;
+
+        if (*p != ':')
+            break;
+        p++;
+    }
+
+    *seconds = sign * (fields[0] * 3600 + fields[1] * 60 + fields[2]);
+    return p;
+}
+
+static const char* ParseZoneDate(const char* p, TimeZoneDate* date)
+{
+    char* end;
+    *date = { 'N', 0, 0, 0, DEFAULT_RULE_TIME };
+
+    if (*p == 'M')
+    {
+        date->kind  = 'M';
+        date->month = (int)strtol(p + 1, &end, 10);
+        if (*end != '.')
+            return nullptr;
+        date->week = (int)strtol(end + 1, &end, 10);
+        if (*end != '.')
+            return nullptr;
+        date->day = (int)strtol(end + 1, &end, 10);
+    }
+    else
+    {
+        if (*p == 'J')
+        {
+            date->kind = 'J';
+            p++;
+        }
+        if (*p < '0' || *p > '9')
+            return nullptr;
+        date->day = (int)strtol(p, &end, 10);
+    }
+
+    p = end;
+    if (*p == '/')
+        p = ParseZoneSeconds(p + 1, &date->time);
+
+    return p;
+}
+
+static bool ParseZoneRule(const char* p, TimeZoneRule* rule)
+{
+    int offset;
+
+    p = ParseZoneName(p);
+    if (!p || !(p = ParseZoneSeconds(p, &offset)))
+        return false;
+
+    // POSIX offsets count westwards
+    rule->stdOffset = -offset;
+    rule->dstOffset = rule->stdOffset;
+    rule->dst       = *p != '\0';
+    if (!rule->dst)
+        return true;
+
+    if (!(p = ParseZoneName(p)))
+        return false;
+
+    rule->dstOffset = rule->stdOffset + 3600;
+    if (*p != ',' && *p != '\0')
+    {
+        if (!(p = ParseZoneSeconds(p, &offset)))
+            return false;
+        rule->dstOffset = -offset;
+    }
+
+    if (*p != ',')
+    {
+        // No dates given, same default as glibc
+        ParseZoneDate("M3.2.0", &rule->start);
+        ParseZoneDate("M11.1.0", &rule->end);
+        return true;
+    }
+
+    if (!(p = ParseZoneDate(p + 1, &rule->start)) || *p != ',')
+        return false;
+
+    return ParseZoneDate(p + 1, &rule->end) != nullptr;
+}
+
+long long DaysFromCivil(long long year, int month, int day)
+{
+    year -= month <= 2;
+    long long era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = (int)(year - era * 400);
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void CivilFromDays(long long days, long long* year, int* month, int* day)
+{
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    int doe = (int)(days - era * 146097);
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp  = (5 * doy + 2) / 153;
+
+    *day   = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year  = yoe + era * 400 + (*month <= 2);
+}
+
+// Local midnight of the rule date in the given year, in days since epoch
+static long long GetZoneDateDays(const TimeZoneDate& date, long long year)
+{
+    long long newYear = DaysFromCivil(year, 1, 1);
+
+    if (date.kind == 'J')
+        return newYear + date.day - 1 + (IsLeapYear(year) && date.day >= 60 ? 1 : 0);
+
+    if (date.kind == 'N')
+        return newYear + date.day;
+
+    long long first = DaysFromCivil(year, date.month, 1);
+    int weekday     = (int)(((first % 7) + 7 + 4) % 7); // 1970-01-01 was a Thursday
+    long long days  = first + (date.day - weekday + 7) % 7 + (date.week - 1) * 7;
+
+    long long nextMonth = date.month == 12 ? DaysFromCivil(year + 1, 1, 1) : DaysFromCivil(year, date.month + 1, 1);
+    while (days >= nextMonth)
+        days -= 7;
+
+    return days;
+}
+
+static void AddTransition(TimeZone* zone, long long time, int offset)
+{
+    if (!zone->transitions.empty() && time <= zone->transitions.back())
+        return;
+
+    zone->transitions.push_back(time);
+    zone->offsets.push_back(offset);
+}
+
+// Expands the footer rule into explicit transitions, so lookups never evaluate rules
+static void ExpandZoneRule(TimeZone* zone, const TimeZoneRule& rule)
+{
+    if (!rule.dst)
+        return;
+
+    long long firstYear = 1970;
+    if (!zone->transitions.empty())
+    {
+        long long year;
+        int month, day;
+        CivilFromDays(zone->transitions.back() / 86400, &year, &month, &day);
+        firstYear = year;
+    }
+
+    for (long long year = firstYear; year <= TIMEZONE_LAST_YEAR; year++)
+    {
+        // DST starts at a standard time wall clock and ends at a DST wall clock
+        long long start = GetZoneDateDays(rule.start, year) * 86400 + rule.start.time - rule.stdOffset;
+        long long end   = GetZoneDateDays(rule.end, year) * 86400 + rule.end.time - rule.dstOffset;
+
+        if (start < end)
+        {
+            AddTransition(zone, start, rule.dstOffset);
+            AddTransition(zone, end, rule.stdOffset);
+        }
+        else
+        {
+            AddTransition(zone, end, rule.stdOffset);
+            AddTransition(zone, start, rule.dstOffset);
+        }
+    }
+}
+
+static bool ParseTZif(TimeZone* zone, const vector<unsigned char>& data)
+{
+    size_t position = 0;
+    int timeSize    = 4;
+
+    // Version 1 block with 32-bit times, skipped in favour of the 64-bit block when present
+    for (int block = 0; block < 2; block++)
+    {
+        if (data.size() < position + TZIF_HEADER_SIZE || data[position] != 'T' || data[position + 1] != 'Z' ||
+            data[position + 2] != 'i' || data[position + 3] != 'f')
+            return false;
+
+        const unsigned char* header = data.data() + position;
+        char version = (char)header[4];
+
+        long long isutCount  = ReadBigEndian(header + 20, 4);
+        long long isstdCount = ReadBigEndian(header + 24, 4);
+        long long leapCount  = ReadBigEndian(header + 28, 4);
+        long long timeCount  = ReadBigEndian(header + 32, 4);
+        long long typeCount  = ReadBigEndian(header + 36, 4);
+        long long charCount  = ReadBigEndian(header + 40, 4);
+
+        size_t size = (size_t)(timeCount * timeSize + timeCount + typeCount * 6 + charCount +
+                               leapCount * (timeSize + 4) + isstdCount + isutCount);
+
+        position += TZIF_HEADER_SIZE;
+        if (typeCount <= 0 || data.size() < position + size)
+            return false;
+
+        if (block == 0 && version >= '2')
+        {
+            position += size;
+            timeSize  = 8;
+            continue;
+        }
+
+        const unsigned char* times = data.data() + position;
+        const unsigned char* types = times + timeCount * timeSize;
+        const unsigned char* infos = types + timeCount;
+
+        zone->transitions.clear();
+        zone->offsets.clear();
+        zone->initialOffset = (int)ReadBigEndian(infos, 4);
+
+        for (long long i = 0; i < timeCount; i++)
+        {
+            if (types[i] >= typeCount)
+                return false;
+
+            AddTransition(zone, ReadBigEndian(times + i * timeSize, timeSize), (int)ReadBigEndian(infos + types[i] * 6, 4));
+        }
+
+        position += size;
+        break;
+    }
+
+    // Footer "\n<TZ string>\n", version 2+ only
+    if (timeSize == 8 && position < data.size() && data[position] == '\n')
+    {
+        string footer(data.begin() + position + 1, data.end());
+        footer = footer.substr(0, footer.find('\n'));
+
+        TimeZoneRule rule;
+        if (!footer.empty() && ParseZoneRule(footer.c_str(), &rule))
+            ExpandZoneRule(zone, rule);
+    }
+
+    return true;
+}
+
+bool LoadTimeZone(TimeZone* zone, const char* name)
+{
+    string path = name;
+    if (path.empty() || path.find("..") != string::npos)
+        return false;
+
+    if (path[0] != '/')
+    {
+        const char* directory = getenv("TZDIR");
+        path = string(directory ? directory : ZONEINFO_DIRECTORY) + "/" + path;
+    }
+
+    ifstream ifs(path, ios::binary);
+    if (!ifs.is_open())
+        return false;
+
+    vector<unsigned char> data((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    return ParseTZif(zone, data);
+}
+
+int GetTimeZoneOffset(const TimeZone& zone, long long utcSeconds)
+{
+    auto next = upper_bound(zone.transitions.begin(), zone.transitions.end(), utcSeconds);
+    if (next == zone.transitions.begin())
+        return zone.initialOffset;
+
+    return zone.offsets[next - zone.transitions.begin() - 1];
+}
@@ -0,0 +1,26 @@
+#ifndef TIMEZONE_H
+#define TIMEZONE_H
+
+#include <vector>
+
+using namespace std;
+
+const int TIMEZONE_LAST_YEAR = 2100; // Rule-based transitions are expanded up to this year
+
+// UTC offsets of one zone as a sorted transition table, loaded once from a TZif file
+typedef struct
+{
+    vector<long long> transitions; // UTC seconds since epoch at which offsets[i] starts
+    vector<int> offsets;           // UTC offset (seconds)
+    int initialOffset;             // Offset before the first transition
+} TimeZone;
+
+// Name is relative to $TZDIR or /usr/share/zoneinfo (e.g. "Europe/Berlin") or an absolute path
+bool LoadTimeZone(TimeZone* zone, const char* name);
+int GetTimeZoneOffset(const TimeZone& zone, long long utcSeconds);
+
+// Proleptic Gregorian calendar, days since 1970-01-01, month 1-12
+long long DaysFromCivil(long long year, int month, int day);
+void CivilFromDays(long long days, long long* year, int* month, int* day);
+
+#endif
@@ -0,0 +1,530 @@
+#include "trail.h"
+#include "trailkernel.h"
+#include "workers.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#include <cmath>
+
+const Color TRAIL_COLOR = { 133, 255, 255, 255 };
+
+const int TRAIL_BLOCK    = TRAIL_POINTS + 2;       // Points per orb, padded with a copy of each end
+const int TRAIL_VERTICES = ORBS * TRAIL_BLOCK * 2;
+const int TRAIL_INDICES  = ORBS * TRAIL_SEGMENTS * 6;
+
+const int TRAIL_VERTEX_STRIDE = 4 * sizeof(float);
+const int TRAIL_POINT_STRIDE  = 2 * TRAIL_VERTEX_STRIDE;
+
+const float TRAIL_SEGMENT_PIXELS = 6.f;           // Screen length covered by one segment
+const float TRAIL_SEGMENT_ANGLE  = 5.f * DEG2RAD; // Screen-space turn covered by one segment
+
+// Samples grid indices first..last into their slots, in at most two contiguous runs
+static void SampleTrailGrid(TrailHistory* history, const OrbitAnchor& anchor, double time, long long first, long long last)
+{
+    float offsets[TRAIL_SEGMENTS];
+    while (first <= last)
+    {
+        int slot  = (int)(first % TRAIL_SEGMENTS);
+        int count = (int)fmin((double)(last - first + 1), (double)(TRAIL_SEGMENTS - slot));
+
+        for (int i = 0; i < count; i++)
+            offsets[i] = (float)(time - (first + i) * (double)TRAIL_SAMPLE_STEP);
+
+        SampleOrbPositionsSoA(anchor, offsets, count, 1.f, &history->x[0][slot], &history->y[0][slot], &history->z[0][slot], TRAIL_SEGMENTS);
+        first += count;
+    }
+}
+
+void ResetTrailHistory(TrailHistory* history)
+{
+    history->valid = false;
+}
+
+void UpdateTrailHistory(TrailHistory* history, const OrbitAnchor& anchor, double time)
+{
+    // Only grid points passed since the last frame are sampled, none at all on most frames above 60 Hz.
+    // A frame longer than the whole trail (fast warp clocks) samples the window once.
+    long long newest = (long long)floor(time / TRAIL_SAMPLE_STEP);
+    long long oldest = newest - TRAIL_SEGMENTS + 1;
+    long long first  = history->valid && history->newest >= oldest ? history->newest + 1 : oldest;
+    SampleTrailGrid(history, anchor, time, first, newest);
+
+    SampleOrbPositions(anchor, 0.f, 1.f, history->live);
+
+    history->newest = newest;
+    history->time   = time;
+    history->valid  = true;
+}
+
+Vector3 GetTrailPosition(const TrailHistory& history, int orbIndex, int sampleIndex)
+{
+    if (sampleIndex == 0)
+        return history.live[orbIndex];
+
+    int slot = (int)((history.newest - sampleIndex + 1) % TRAIL_SEGMENTS);
+    return { history.x[orbIndex][slot], history.y[orbIndex][slot], history.z[orbIndex][slot] };
+}
+
+float GetTrailSampleAge(const TrailHistory& history, int sampleIndex)
+{
+    if (sampleIndex == 0)
+        return 0.f;
+
+    return (float)(history.time - (history.newest - sampleIndex + 1) * (double)TRAIL_SAMPLE_STEP);
+}
+
+static void BindTrailAttribute(int location, unsigned int vboId, int size, int stride, int offset)
+{
+    if (location < 0)
+        return;
+
+    rlEnableVertexBuffer(vboId);
+    rlSetVertexAttribute(location, size, RL_FLOAT, false, stride, offset);
+    rlEnableVertexAttribute(location);
+}
+
+static void BindTrailAttributes(const TrailMesh& trail)
+{
+    // The same points are read three times, shifted by one point, to give the
+    // vertex shader both neighbours of every centerline point
+    BindTrailAttribute(trail.previousLoc, trail.vboId, 4, TRAIL_VERTEX_STRIDE, 0);
+    BindTrailAttribute(trail.shader.locs[SHADER_LOC_VERTEX_POSITION], trail.vboId, 4, TRAIL_VERTEX_STRIDE, TRAIL_POINT_STRIDE);
+    BindTrailAttribute(trail.nextLoc, trail.vboId, 4, TRAIL_VERTEX_STRIDE, 2 * TRAIL_POINT_STRIDE);
+    BindTrailAttribute(trail.sideLoc, trail.sideVboId, 1, 0, 0);
+
+    rlEnableVertexBufferElement(trail.eboId);
+}
+
+// Two vertices per point (left/right edge), two triangles per segment
+static void GenTrailIndices(unsigned short* indices, int pointsPerOrb)
+{
+    unsigned short* index = indices;
+    for (int orb = 0; orb < ORBS; orb++)
+    {
+        for (int i = 0; i < TRAIL_SEGMENTS; i++)
+        {
+            unsigned short A = (unsigned short)((orb * pointsPerOrb + i) * 2);
+            unsigned short B = A + 1;
+            unsigned short C = A + 2;
+            unsigned short D = A + 3;
+
+            *index++ = A; *index++ = B; *index++ = C;
+            *index++ = C; *index++ = B; *index++ = D;
+        }
+    }
+}
+
+static void SetTrailUniforms(Shader shader, const Camera& camera)
+{
+    Vector3 viewDir = Vector3Normalize(Vector3Subtract(camera.target, camera.position));
+    Vector4 color   = ColorNormalize(TRAIL_COLOR);
+    Vector4 white   = { 1.f, 1.f, 1.f, 1.f };
+    float width     = TRAIL_WIDTH * 0.05f;
+    float fadeTime  = TRAIL_FADE_TIME / 1000.f;
+
+    SetShaderValue(shader, GetShaderLocation(shader, "viewDir"),    &viewDir,   SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, GetShaderLocation(shader, "cameraUp"),   &camera.up, SHADER_UNIFORM_VEC3);
+    SetShaderValue(shader, GetShaderLocation(shader, "width"),      &width,     SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "fadeTime"),   &fadeTime,  SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shader, GetShaderLocation(shader, "trailColor"), &color,     SHADER_UNIFORM_VEC4);
+    SetShaderValue(shader, shader.locs[SHADER_LOC_COLOR_DIFFUSE],   &white,     SHADER_UNIFORM_VEC4);
+}
+
+static void BeginTrailShader(Shader shader)
+{
+    rlEnableShader(shader.id);
+
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], mvp);
+
+    rlActiveTextureSlot(0);
+    rlEnableTexture(rlGetTextureIdDefault());
+}
+
+static void EndTrailShader()
+{
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+TrailMesh LoadTrailMesh(Shader shader, const Camera& camera, int vertexBudget)
+{
+    TrailMesh trail = { 0 };
+    trail.shader       = shader;
+    trail.vertexBudget = vertexBudget;
+    trail.detail       = 1.f;
+    trail.previousLoc = GetShaderLocationAttrib(shader, "vertexPrevious");
+    trail.nextLoc     = GetShaderLocationAttrib(shader, "vertexNext");
+    trail.sideLoc     = GetShaderLocationAttrib(shader, "vertexSide");
+    trail.radiusLoc   = GetShaderLocation(shader, "radius");
+    trail.points[0]   = (float*)MemAlloc(TRAIL_VERTICES * 4 * sizeof(float));
+    trail.points[1]   = (float*)MemAlloc(TRAIL_VERTICES * 4 * sizeof(float));
+
+    float* sides            = (float*)MemAlloc(TRAIL_VERTICES * sizeof(float));
+    unsigned short* indices = (unsigned short*)MemAlloc(TRAIL_INDICES * sizeof(unsigned short));
+
+    for (int v = 0; v < TRAIL_VERTICES; v++)
+        sides[v] = (v % 2 == 0) ? 1.f : -1.f;
+
+    GenTrailIndices(indices, TRAIL_BLOCK);
+
+    trail.vaoId     = rlLoadVertexArray();
+    bool vao        = rlEnableVertexArray(trail.vaoId);
+    trail.vboId     = rlLoadVertexBuffer(trail.points[0], TRAIL_VERTICES * TRAIL_VERTEX_STRIDE, true);
+    trail.sideVboId = rlLoadVertexBuffer(sides, TRAIL_VERTICES * sizeof(float), false);
+    trail.eboId     = rlLoadVertexBufferElement(indices, TRAIL_INDICES * sizeof(unsigned short), false);
+
+    if (vao)
+    {
+        BindTrailAttributes(trail);
+        rlDisableVertexArray();
+    }
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+
+    MemFree(sides);
+    MemFree(indices);
+
+    SetTrailUniforms(shader, camera);
+    return trail;
+}
+
+static Vector2 ProjectTrailPoint(Vector3 P, const Matrix& m, Vector2 viewport)
+{
+    float x = m.m0 * P.x + m.m4 * P.y + m.m8  * P.z + m.m12;
+    float y = m.m1 * P.x + m.m5 * P.y + m.m9  * P.z + m.m13;
+    float w = m.m3 * P.x + m.m7 * P.y + m.m11 * P.z + m.m15;
+
+    if (w <= 0.f)
+        return { 0.f, 0.f };
+
+    return { x / w * 0.5f * viewport.x, y / w * 0.5f * viewport.y };
+}
+
+// One task per orb, each fills its own block of the back buffer
+static void BuildTrailBlock(void* data, int orb)
+{
+    TrailMesh* trail            = (TrailMesh*)data;
+    const TrailHistory& history = *trail->history;
+    Vector4* block              = (Vector4*)trail->points[1 - trail->front] + orb * TRAIL_BLOCK * 2;
+
+    Vector2 screen[TRAIL_POINTS];
+    for (int i = 0; i < TRAIL_POINTS; i++)
+    {
+        Vector3 P = Vector3Scale(GetTrailPosition(history, orb, i), trail->radius);
+        screen[i] = ProjectTrailPoint(P, trail->viewProjection, trail->viewport);
+    }
+
+    // Segments wanted between neighbouring history samples, by length or by turn
+    float cost[TRAIL_SEGMENTS];
+    float wanted = 0.f;
+    for (int i = 0; i < TRAIL_SEGMENTS; i++)
+    {
+        Vector2 d = Vector2Subtract(screen[i + 1], screen[i]);
+        float turn = 0.f;
+        if (i > 0)
+        {
+            Vector2 p = Vector2Subtract(screen[i], screen[i - 1]);
+            turn = fabsf(atan2f(p.x * d.y - p.y * d.x, Vector2DotProduct(p, d)));
+        }
+
+        cost[i] = fmaxf(Vector2Length(d) / TRAIL_SEGMENT_PIXELS, turn / TRAIL_SEGMENT_ANGLE);
+        wanted += cost[i];
+    }
+    trail->wanted[orb] = wanted;
+
+    // Keep a sample every time the accumulated cost crosses a whole segment,
+    // the newest and the oldest sample are always kept
+    int count    = 0;
+    float amount = 0.f;
+    for (int i = 0; i < TRAIL_POINTS; i++)
+    {
+        if (i > 0)
+            amount += cost[i - 1] * trail->detail;
+
+        if (i > 0 && i < TRAIL_POINTS - 1 && amount < 1.f)
+            continue;
+
+        Vector3 P = GetTrailPosition(history, orb, i);
+        Vector4 point = { P.x, P.y, P.z, GetTrailSampleAge(history, i) };
+
+        count++;
+        block[count * 2]     = point;
+        block[count * 2 + 1] = point;
+        amount = fmodf(amount, 1.f);
+    }
+
+    block[0] = block[1] = block[2];
+    block[(count + 1) * 2] = block[(count + 1) * 2 + 1] = block[count * 2];
+
+    trail->segments[1 - trail->front][orb] = count - 1;
+}
+
+void BuildTrailMesh(TrailMesh* trail, const TrailHistory& history, const Camera& camera, float radius, int width, int height)
+{
+    SwapTrailMesh(trail);
+
+    Matrix view       = GetCameraMatrix(camera);
+    Matrix projection = MatrixPerspective(
+            camera.fovy * DEG2RAD,
+            (double)width / (double)height,
+            RL_CULL_DISTANCE_NEAR,
+            RL_CULL_DISTANCE_FAR
+    );
+
+    trail->history        = &history;
+    trail->viewProjection = MatrixMultiply(view, projection);
+    trail->viewport       = { (float)width, (float)height };
+    trail->radius         = radius;
+    trail->building       = true;
+
+    DispatchWorkers(BuildTrailBlock, trail, ORBS);
+}
+
+void SwapTrailMesh(TrailMesh* trail)
+{
+    if (!trail->building)
+        return;
+
+    WaitWorkers();
+    trail->building = false;
+    trail->front    = 1 - trail->front;
+
+    for (int orb = 0; orb < ORBS; orb++)
+    {
+        int offset = orb * TRAIL_BLOCK * 2;
+        int points = trail->segments[trail->front][orb] + 3;
+
+        rlUpdateVertexBuffer(
+                trail->vboId,
+                (Vector4*)trail->points[trail->front] + offset,
+                points * TRAIL_POINT_STRIDE,
+                offset * TRAIL_VERTEX_STRIDE
+        );
+    }
+
+    // Scale the next build to the budget, trails move a fraction of a pixel per frame
+    // so the detail wanted now is a close estimate of the detail wanted next frame
+    if (trail->vertexBudget > 0)
+    {
+        float wanted = 0.f;
+        for (int orb = 0; orb < ORBS; orb++)
+            wanted += trail->wanted[orb];
+
+        // Two vertices per point, every orb adds its newest point and may round up its oldest
+        float available = (float)(trail->vertexBudget / 2 - 2 * ORBS);
+        trail->detail   = wanted > available ? fmaxf(available, 0.f) / wanted : 1.f;
+    }
+}
+
+void DrawTrailMesh(const TrailMesh& trail)
+{
+    BeginTrailShader(trail.shader);
+    rlSetUniform(trail.radiusLoc, &trail.radius, SHADER_UNIFORM_FLOAT, 1);
+
+    bool vao = rlEnableVertexArray(trail.vaoId);
+    if (!vao)
+        BindTrailAttributes(trail);
+
+    for (int orb = 0; orb < ORBS; orb++)
+        rlDrawVertexArrayElements(orb * TRAIL_SEGMENTS * 6, trail.segments[trail.front][orb] * 6, 0);
+
+    if (!vao)
+    {
+        // Leave only the default attributes enabled for the render batch
+        if (trail.previousLoc >= 0) rlDisableVertexAttribute(trail.previousLoc);
+        if (trail.nextLoc >= 0)     rlDisableVertexAttribute(trail.nextLoc);
+        if (trail.sideLoc >= 0)     rlDisableVertexAttribute(trail.sideLoc);
+    }
+
+    EndTrailShader();
+}
+
+void UnloadTrailMesh(TrailMesh trail)
+{
+    rlUnloadVertexArray(trail.vaoId);
+    rlUnloadVertexBuffer(trail.vboId);
+    rlUnloadVertexBuffer(trail.sideVboId);
+    rlUnloadVertexBuffer(trail.eboId);
+    MemFree(trail.points[0]);
+    MemFree(trail.points[1]);
+}
+
+static void BindProceduralTrailAttributes(const ProceduralTrail& trail)
+{
+    rlEnableVertexBuffer(trail.vboId);
+    rlSetVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION);
+    rlEnableVertexBufferElement(trail.eboId);
+}
+
+ProceduralTrail LoadProceduralTrail(Shader shader, const Camera& camera)
+{
+    const int vertexCount = ORBS * TRAIL_POINTS * 2;
+
+    ProceduralTrail trail = { 0 };
+    trail.shader       = shader;
+    trail.secondsLoc   = GetShaderLocation(shader, "secondsInMinute");
+    trail.keyframeLoc  = GetShaderLocation(shader, "minuteKeyframe");
+    trail.hourAngleLoc = GetShaderLocation(shader, "hourAngle");
+    trail.radiusLoc    = GetShaderLocation(shader, "radius");
+
+    Vector3* vertices       = (Vector3*)MemAlloc(vertexCount * sizeof(Vector3));
+    unsigned short* indices = (unsigned short*)MemAlloc(TRAIL_INDICES * sizeof(unsigned short));
+
+    for (int orb = 0; orb < ORBS; orb++)
+    {
+        for (int i = 0; i < TRAIL_POINTS; i++)
+        {
+            int v = (orb * TRAIL_POINTS + i) * 2;
+            vertices[v]     = { (float)orb, (float)i,  1.f };
+            vertices[v + 1] = { (float)orb, (float)i, -1.f };
+        }
+    }
+    GenTrailIndices(indices, TRAIL_POINTS);
+
+    trail.vaoId = rlLoadVertexArray();
+    bool vao    = rlEnableVertexArray(trail.vaoId);
+    trail.vboId = rlLoadVertexBuffer(vertices, vertexCount * sizeof(Vector3), false);
+    trail.eboId = rlLoadVertexBufferElement(indices, TRAIL_INDICES * sizeof(unsigned short), false);
+
+    if (vao)
+    {
+        BindProceduralTrailAttributes(trail);
+        rlDisableVertexArray();
+    }
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+
+    MemFree(vertices);
+    MemFree(indices);
+
+    float sampleStep = TRAIL_SAMPLE_STEP;
+    SetShaderValue(shader, GetShaderLocation(shader, "sampleStep"), &sampleStep, SHADER_UNIFORM_FLOAT);
+    SetTrailUniforms(shader, camera);
+
+    return trail;
+}
+
+void DrawProceduralTrail(const ProceduralTrail& trail, const OrbitAnchor& anchor, float radius)
+{
+    float keyframe = (float)(((anchor.minute % 3) + 3) % 3);
+
+    BeginTrailShader(trail.shader);
+    rlSetUniform(trail.secondsLoc,   &anchor.secondsInMinute, SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(trail.keyframeLoc,  &keyframe,               SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(trail.hourAngleLoc, &anchor.hourAngle,       SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(trail.radiusLoc,    &radius,                 SHADER_UNIFORM_FLOAT, 1);
+
+    if (!rlEnableVertexArray(trail.vaoId))
+        BindProceduralTrailAttributes(trail);
+
+    rlDrawVertexArrayElements(0, TRAIL_INDICES, 0);
+    EndTrailShader();
+}
+
+void UnloadProceduralTrail(ProceduralTrail trail)
+{
+    rlUnloadVertexArray(trail.vaoId);
+    rlUnloadVertexBuffer(trail.vboId);
+    rlUnloadVertexBuffer(trail.eboId);
+}
+
+FeedbackTrail LoadFeedbackTrail(Shader shader, int width, int height)
+{
+    FeedbackTrail trail = { 0 };
+    trail.targets[0] = LoadRenderTexture(width, height);
+    trail.targets[1] = LoadRenderTexture(width, height);
+    trail.shader     = shader;
+    trail.decayLoc   = GetShaderLocation(shader, "decay");
+    return trail;
+}
+
+static void DrawTrailSegment(Vector3 from, Vector3 to, const Camera& camera)
+{
+    Vector3 viewDir = Vector3Subtract(camera.target, camera.position);
+    Vector3 side    = Vector3CrossProduct(viewDir, Vector3Subtract(to, from));
+
+    if (FloatEquals(Vector3Length(side), 0.f))
+        return;
+
+    side = Vector3Scale(Vector3Normalize(side), TRAIL_WIDTH * 0.05f);
+
+    Vector3 A = Vector3Add(from, side);
+    Vector3 B = Vector3Subtract(from, side);
+    Vector3 C = Vector3Add(to, side);
+    Vector3 D = Vector3Subtract(to, side);
+
+    DrawTriangle3D(A, B, C, TRAIL_COLOR);
+    DrawTriangle3D(C, B, D, TRAIL_COLOR);
+}
+
+void ResetFeedbackTrail(FeedbackTrail* trail)
+{
+    trail->valid = false;
+}
+
+void UpdateFeedbackTrail(FeedbackTrail* trail, const Camera& camera, const OrbitAnchor& anchor, double time, float radius)
+{
+    Vector3 heads[ORBS];
+    SampleOrbPositions(anchor, 0.f, radius, heads);
+
+    double gap = time - trail->time;
+
+    const RenderTexture& previous = trail->targets[trail->current];
+    trail->current = 1 - trail->current;
+
+    BeginTextureMode(trail->targets[trail->current]);
+        ClearBackground(BLANK);
+        if (trail->valid)
+        {
+            // Same 1.0 -> 0.1 fade over TRAIL_FADE_TIME as the geometry trails, but exponential
+            float decay = powf(0.1f, (float)gap / (TRAIL_FADE_TIME / 1000.f));
+            SetShaderValue(trail->shader, trail->decayLoc, &decay, SHADER_UNIFORM_FLOAT);
+
+            rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+            BeginBlendMode(BLEND_CUSTOM);
+            BeginShaderMode(trail->shader);
+                DrawTextureRec(
+                        previous.texture,
+                        { 0, 0, (float)previous.texture.width, (float)-previous.texture.height },
+                        { 0, 0 },
+                        WHITE
+                );
+            EndShaderMode();
+            EndBlendMode();
+
+            BeginMode3D(camera);
+            BeginBlendMode(BLEND_ADDITIVE);
+                for (int i = 0; i < ORBS; i++)
+                    DrawTrailSegment(trail->heads[i], heads[i], camera);
+            EndBlendMode();
+            EndMode3D();
+        }
+    EndTextureMode();
+
+    for (int i = 0; i < ORBS; i++)
+        trail->heads[i] = heads[i];
+
+    trail->time  = time;
+    trail->valid = true;
+}
+
+void DrawFeedbackTrail(const FeedbackTrail& trail)
+{
+    const Texture& texture = trail.targets[trail.current].texture;
+
+    rlSetBlendFactors(RL_ONE, RL_ONE, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+        DrawTextureRec(texture, { 0, 0, (float)texture.width, (float)-texture.height }, { 0, 0 }, WHITE);
+    EndBlendMode();
+}
+
+void UnloadFeedbackTrail(FeedbackTrail trail)
+{
+    UnloadRenderTexture(trail.targets[0]);
+    UnloadRenderTexture(trail.targets[1]);
+}
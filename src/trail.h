@@ -0,0 +1,124 @@
+#ifndef TRAIL_H
+#define TRAIL_H
+
+#include "raylib.h"
+#include "orbit.h"
+
+constexpr float TRAIL_DURATION    = 2.f;         // Trail length (seconds)
+constexpr float TRAIL_SAMPLE_STEP = 1.f / 60.f;  // Time grid trails are sampled on (seconds)
+
+const int TRAIL_SEGMENTS = (int)(TRAIL_DURATION / TRAIL_SAMPLE_STEP + 0.5f);
+const int TRAIL_POINTS   = TRAIL_SEGMENTS + 1;
+
+const float TRAIL_WIDTH     = 1.0f;
+const float TRAIL_FADE_TIME = 2000.f;
+
+enum TrailMode
+{
+    TRAIL_MODE_HISTORY,    // Streamed ring buffer of past orb positions
+    TRAIL_MODE_PROCEDURAL, // Evaluated in the vertex shader from time uniforms, no uploads
+    TRAIL_MODE_FEEDBACK    // Previous trail image decayed every frame, only the newest segments are drawn
+};
+
+// Orb positions on a fixed time grid, grid index k is sampled at wall time k * TRAIL_SAMPLE_STEP
+// once and stays in slot k % TRAIL_SEGMENTS until it is older than the trail. The live position
+// at the current time is kept separately, so trails reach the orbs at any frame rate.
+typedef struct
+{
+    float x[ORBS][TRAIL_SEGMENTS]; // Orb positions on a unit-radius orbit, one array per coordinate
+    float y[ORBS][TRAIL_SEGMENTS];
+    float z[ORBS][TRAIL_SEGMENTS];
+    Vector3 live[ORBS];
+
+    long long newest; // Grid index of the newest sample
+    double time;      // Wall time of the live positions (seconds)
+    bool valid;
+} TrailHistory;
+
+// Centerline points of all orb trails in one streamed buffer, extruded into
+// camera facing ribbons by trail.vs. The points are double-buffered: workers
+// fill the back buffer while the frame renders. History samples are kept by
+// projected length and curvature, so each orb uses only as many segments as
+// are visible on screen.
+typedef struct
+{
+    unsigned int vaoId;
+    unsigned int vboId;     // Dynamic: centerline point + age, two vertices per point
+    unsigned int sideVboId; // Static: ribbon side (-1/+1) of every vertex
+    unsigned int eboId;
+
+    Shader shader;
+    int previousLoc;
+    int nextLoc;
+    int sideLoc;
+    int radiusLoc;
+
+    float* points[2];
+    int segments[2][ORBS];       // Segments kept per orb in each buffer
+    int front;                   // Buffer last uploaded to vboId
+    bool building;               // Back buffer is being filled by the workers
+
+    int vertexBudget;            // Upper limit for all orbs, 0 = no limit
+    float detail;                // Fraction of the wanted segments that fits the budget
+    float wanted[ORBS];          // Segments each orb wanted in the last build
+
+    const TrailHistory* history; // Inputs of the running build
+    Matrix viewProjection;
+    Vector2 viewport;
+    float radius;
+} TrailMesh;
+
+// Static (orb, sample, side) grid, trail_procedural.vs evaluates the orbit for every vertex
+typedef struct
+{
+    unsigned int vaoId;
+    unsigned int vboId;
+    unsigned int eboId;
+
+    Shader shader;
+    int secondsLoc;
+    int keyframeLoc;
+    int hourAngleLoc;
+    int radiusLoc;
+} ProceduralTrail;
+
+// Ping-pong render targets holding the trail image, geometry cost does not depend on trail length
+typedef struct
+{
+    RenderTexture targets[2];
+    int current;
+
+    Shader shader;
+    int decayLoc;
+
+    Vector3 heads[ORBS]; // Orb positions of the previous frame
+    double time;         // Wall time of the previous frame
+    bool valid;
+} FeedbackTrail;
+
+// Called on clock jumps, the next update samples the whole history again
+void ResetTrailHistory(TrailHistory* history);
+void UpdateTrailHistory(TrailHistory* history, const OrbitAnchor& anchor, double time);
+
+// Sample index 0 is the live position, grid samples follow from newest to oldest
+Vector3 GetTrailPosition(const TrailHistory& history, int orbIndex, int sampleIndex);
+float GetTrailSampleAge(const TrailHistory& history, int sampleIndex);
+
+TrailMesh LoadTrailMesh(Shader shader, const Camera& camera, int vertexBudget);
+// Build runs on the worker pool, history must stay untouched until the swap
+void BuildTrailMesh(TrailMesh* trail, const TrailHistory& history, const Camera& camera, float radius, int width, int height);
+void SwapTrailMesh(TrailMesh* trail);
+void DrawTrailMesh(const TrailMesh& trail);
+void UnloadTrailMesh(TrailMesh trail);
+
+ProceduralTrail LoadProceduralTrail(Shader shader, const Camera& camera);
+void DrawProceduralTrail(const ProceduralTrail& trail, const OrbitAnchor& anchor, float radius);
+void UnloadProceduralTrail(ProceduralTrail trail);
+
+FeedbackTrail LoadFeedbackTrail(Shader shader, int width, int height);
+void ResetFeedbackTrail(FeedbackTrail* trail);
+void UpdateFeedbackTrail(FeedbackTrail* trail, const Camera& camera, const OrbitAnchor& anchor, double time, float radius);
+void DrawFeedbackTrail(const FeedbackTrail& trail);
+void UnloadFeedbackTrail(FeedbackTrail trail);
+
+#endif
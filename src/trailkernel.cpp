@@ -0,0 +1,332 @@
+#include "trailkernel.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define TRAIL_KERNEL_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define TRAIL_KERNEL_ARM
+    #include <arm_neon.h>
+#endif
+
+// MSVC accepts any intrinsic, GCC and Clang need the instruction set enabled per function
+#if defined(__GNUC__)
+    #define TRAIL_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define TRAIL_KERNEL_TARGET(isa)
+#endif
+
+const int TRAIL_KERNEL_CHUNK = 64; // Samples prepared per pass, keeps the lanes on the stack
+
+// Per-sample terms of the orbit, one lane per sample. Orb i sits at angle
+// orb0 + i * step in the orbit plane, so after the plane is tilted by the X
+// rotation and turned by the hour angle:
+//     x = cos * xFromCos + sin * xFromSin
+//     y = cos * yFromCos + sin * yFromSin
+//     z =                  sin * zFromSin
+// and each next orb is one angle-addition step away from the previous one.
+typedef struct
+{
+    float cosOrb[TRAIL_KERNEL_CHUNK];
+    float sinOrb[TRAIL_KERNEL_CHUNK];
+    float cosStep[TRAIL_KERNEL_CHUNK];
+    float sinStep[TRAIL_KERNEL_CHUNK];
+    float xFromSin[TRAIL_KERNEL_CHUNK];
+    float yFromSin[TRAIL_KERNEL_CHUNK];
+    float zFromSin[TRAIL_KERNEL_CHUNK];
+
+    float xFromCos; // Hour angle is the same for every sample
+    float yFromCos;
+} OrbitLanes;
+
+typedef void (*SampleLanesFunc)(const OrbitLanes& lanes, int count, float* x, float* y, float* z, int stride);
+
+static void PrepareLanes(OrbitLanes* lanes, const OrbitAnchor& anchor, const float* offsets, int count, float radius)
+{
+    float cosHour = cosf(anchor.hourAngle);
+    float sinHour = sinf(anchor.hourAngle);
+
+    lanes->xFromCos = radius * cosHour;
+    lanes->yFromCos = radius * sinHour;
+
+    for (int j = 0; j < count; j++)
+    {
+        float seconds;
+        int minute;
+
+        GetOrbitTime(anchor, offsets[j], &seconds, &minute);
+        OrbitAngles angles = GetOrbitAngles(seconds, minute);
+
+        float cosX = cosf(angles.x);
+
+        lanes->cosOrb[j]   = cosf(angles.z);
+        lanes->sinOrb[j]   = sinf(angles.z);
+        lanes->cosStep[j]  = cosf(angles.orb);
+        lanes->sinStep[j]  = sinf(angles.orb);
+        lanes->xFromSin[j] = -radius * cosX * sinHour;
+        lanes->yFromSin[j] = radius * cosX * cosHour;
+        lanes->zFromSin[j] = radius * sinf(angles.x);
+    }
+}
+
+static void SampleLanesRange(const OrbitLanes& lanes, int begin, int end, float* x, float* y, float* z, int stride)
+{
+    for (int j = begin; j < end; j++)
+    {
+        float c = lanes.cosOrb[j];
+        float s = lanes.sinOrb[j];
+
+        for (int i = 0; i < ORBS; i++)
+        {
+            x[i * stride + j] = c * lanes.xFromCos + s * lanes.xFromSin[j];
+            y[i * stride + j] = c * lanes.yFromCos + s * lanes.yFromSin[j];
+            z[i * stride + j] = s * lanes.zFromSin[j];
+
+            float next = c * lanes.cosStep[j] - s * lanes.sinStep[j];
+            s = s * lanes.cosStep[j] + c * lanes.sinStep[j];
+            c = next;
+        }
+    }
+}
+
+static void SampleLanesScalar(const OrbitLanes& lanes, int count, float* x, float* y, float* z, int stride)
+{
+    SampleLanesRange(lanes, 0, count, x, y, z, stride);
+}
+
+#if defined(TRAIL_KERNEL_X86)
+TRAIL_KERNEL_TARGET("sse2")
+static void SampleLanesSSE2(const OrbitLanes& lanes, int count, float* x, float* y, float* z, int stride)
+{
+    int wide = count & ~3;
+
+    __m128 xFromCos = _mm_set1_ps(lanes.xFromCos);
+    __m128 yFromCos = _mm_set1_ps(lanes.yFromCos);
+
+    for (int j = 0; j < wide; j += 4)
+    {
+        __m128 c        = _mm_loadu_ps(lanes.cosOrb + j);
+        __m128 s        = _mm_loadu_ps(lanes.sinOrb + j);
+        __m128 cosStep  = _mm_loadu_ps(lanes.cosStep + j);
+        __m128 sinStep  = _mm_loadu_ps(lanes.sinStep + j);
+        __m128 xFromSin = _mm_loadu_ps(lanes.xFromSin + j);
+        __m128 yFromSin = _mm_loadu_ps(lanes.yFromSin + j);
+        __m128 zFromSin = _mm_loadu_ps(lanes.zFromSin + j);
+
+        for (int i = 0; i < ORBS; i++)
+        {
+            _mm_storeu_ps(x + i * stride + j, _mm_add_ps(_mm_mul_ps(c, xFromCos), _mm_mul_ps(s, xFromSin)));
+            _mm_storeu_ps(y + i * stride + j, _mm_add_ps(_mm_mul_ps(c, yFromCos), _mm_mul_ps(s, yFromSin)));
+            _mm_storeu_ps(z + i * stride + j, _mm_mul_ps(s, zFromSin));
+
+            __m128 next = _mm_sub_ps(_mm_mul_ps(c, cosStep), _mm_mul_ps(s, sinStep));
+            s = _mm_add_ps(_mm_mul_ps(s, cosStep), _mm_mul_ps(c, sinStep));
+            c = next;
+        }
+    }
+
+    SampleLanesRange(lanes, wide, count, x, y, z, stride);
+}
+
+TRAIL_KERNEL_TARGET("avx2")
+static void SampleLanesAVX2(const OrbitLanes& lanes, int count, float* x, float* y, float* z, int stride)
+{
+    int wide = count & ~7;
+
+    __m256 xFromCos = _mm256_set1_ps(lanes.xFromCos);
+    __m256 yFromCos = _mm256_set1_ps(lanes.yFromCos);
+
+    for (int j = 0; j < wide; j += 8)
+    {
+        __m256 c        = _mm256_loadu_ps(lanes.cosOrb + j);
+        __m256 s        = _mm256_loadu_ps(lanes.sinOrb + j);
+        __m256 cosStep  = _mm256_loadu_ps(lanes.cosStep + j);
+        __m256 sinStep  = _mm256_loadu_ps(lanes.sinStep + j);
+        __m256 xFromSin = _mm256_loadu_ps(lanes.xFromSin + j);
+        __m256 yFromSin = _mm256_loadu_ps(lanes.yFromSin + j);
+        __m256 zFromSin = _mm256_loadu_ps(lanes.zFromSin + j);
+
+        for (int i = 0; i < ORBS; i++)
+        {
+            _mm256_storeu_ps(x + i * stride + j, _mm256_add_ps(_mm256_mul_ps(c, xFromCos), _mm256_mul_ps(s, xFromSin)));
+            _mm256_storeu_ps(y + i * stride + j, _mm256_add_ps(_mm256_mul_ps(c, yFromCos), _mm256_mul_ps(s, yFromSin)));
+            _mm256_storeu_ps(z + i * stride + j, _mm256_mul_ps(s, zFromSin));
+
+            __m256 next = _mm256_sub_ps(_mm256_mul_ps(c, cosStep), _mm256_mul_ps(s, sinStep));
+            s = _mm256_add_ps(_mm256_mul_ps(s, cosStep), _mm256_mul_ps(c, sinStep));
+            c = next;
+        }
+    }
+
+    SampleLanesRange(lanes, wide, count, x, y, z, stride);
+}
+
+static bool CpuSupportsSSE2()
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static bool CpuSupportsAVX2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // AVX state must also be enabled by the OS
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (!osxsave || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if defined(TRAIL_KERNEL_ARM)
+static void SampleLanesNEON(const OrbitLanes& lanes, int count, float* x, float* y, float* z, int stride)
+{
+    int wide = count & ~3;
+
+    float32x4_t xFromCos = vdupq_n_f32(lanes.xFromCos);
+    float32x4_t yFromCos = vdupq_n_f32(lanes.yFromCos);
+
+    for (int j = 0; j < wide; j += 4)
+    {
+        float32x4_t c        = vld1q_f32(lanes.cosOrb + j);
+        float32x4_t s        = vld1q_f32(lanes.sinOrb + j);
+        float32x4_t cosStep  = vld1q_f32(lanes.cosStep + j);
+        float32x4_t sinStep  = vld1q_f32(lanes.sinStep + j);
+        float32x4_t xFromSin = vld1q_f32(lanes.xFromSin + j);
+        float32x4_t yFromSin = vld1q_f32(lanes.yFromSin + j);
+        float32x4_t zFromSin = vld1q_f32(lanes.zFromSin + j);
+
+        for (int i = 0; i < ORBS; i++)
+        {
+            vst1q_f32(x + i * stride + j, vaddq_f32(vmulq_f32(c, xFromCos), vmulq_f32(s, xFromSin)));
+            vst1q_f32(y + i * stride + j, vaddq_f32(vmulq_f32(c, yFromCos), vmulq_f32(s, yFromSin)));
+            vst1q_f32(z + i * stride + j, vmulq_f32(s, zFromSin));
+
+            float32x4_t next = vsubq_f32(vmulq_f32(c, cosStep), vmulq_f32(s, sinStep));
+            s = vaddq_f32(vmulq_f32(s, cosStep), vmulq_f32(c, sinStep));
+            c = next;
+        }
+    }
+
+    SampleLanesRange(lanes, wide, count, x, y, z, stride);
+}
+#endif
+
+static TrailKernel activeKernel = TRAIL_KERNEL_SCALAR;
+static SampleLanesFunc sampleLanes = NULL;
+
+bool IsTrailKernelSupported(TrailKernel kernel)
+{
+    switch (kernel)
+    {
+    case TRAIL_KERNEL_SCALAR:
+        return true;
+#if defined(TRAIL_KERNEL_X86)
+    case TRAIL_KERNEL_SSE2:
+        return CpuSupportsSSE2();
+    case TRAIL_KERNEL_AVX2:
+        return CpuSupportsAVX2();
+#endif
+#if defined(TRAIL_KERNEL_ARM)
+    case TRAIL_KERNEL_NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* GetTrailKernelName(TrailKernel kernel)
+{
+    switch (kernel)
+    {
+    case TRAIL_KERNEL_SSE2: return "SSE2";
+    case TRAIL_KERNEL_AVX2: return "AVX2";
+    case TRAIL_KERNEL_NEON: return "NEON";
+    default:                return "scalar";
+    }
+}
+
+void SetTrailKernel(TrailKernel kernel)
+{
+    if (!IsTrailKernelSupported(kernel))
+        kernel = TRAIL_KERNEL_SCALAR;
+
+    switch (kernel)
+    {
+#if defined(TRAIL_KERNEL_X86)
+    case TRAIL_KERNEL_SSE2: sampleLanes = SampleLanesSSE2; break;
+    case TRAIL_KERNEL_AVX2: sampleLanes = SampleLanesAVX2; break;
+#endif
+#if defined(TRAIL_KERNEL_ARM)
+    case TRAIL_KERNEL_NEON: sampleLanes = SampleLanesNEON; break;
+#endif
+    default:                sampleLanes = SampleLanesScalar; break;
+    }
+
+    activeKernel = kernel;
+}
+
+TrailKernel GetTrailKernel()
+{
+    if (sampleLanes == NULL)
+    {
+        TrailKernel kernel = TRAIL_KERNEL_SCALAR;
+        if (IsTrailKernelSupported(TRAIL_KERNEL_NEON))
+            kernel = TRAIL_KERNEL_NEON;
+        else if (IsTrailKernelSupported(TRAIL_KERNEL_AVX2))
+            kernel = TRAIL_KERNEL_AVX2;
+        else if (IsTrailKernelSupported(TRAIL_KERNEL_SSE2))
+            kernel = TRAIL_KERNEL_SSE2;
+
+        SetTrailKernel(kernel);
+        TraceLog(LOG_INFO, "TRAIL: Using %s kernel", GetTrailKernelName(kernel));
+    }
+
+    return activeKernel;
+}
+
+void SampleOrbPositionsSoA(
+        const OrbitAnchor& anchor,
+        const float* offsets,
+        int count,
+        float radius,
+        float* x,
+        float* y,
+        float* z,
+        int stride
+)
+{
+    GetTrailKernel();
+
+    OrbitLanes lanes;
+    for (int begin = 0; begin < count; begin += TRAIL_KERNEL_CHUNK)
+    {
+        int chunk = count - begin < TRAIL_KERNEL_CHUNK ? count - begin : TRAIL_KERNEL_CHUNK;
+
+        PrepareLanes(&lanes, anchor, offsets + begin, chunk, radius);
+        sampleLanes(lanes, chunk, x + begin, y + begin, z + begin, stride);
+    }
+}
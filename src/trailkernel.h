@@ -0,0 +1,33 @@
+#ifndef TRAILKERNEL_H
+#define TRAILKERNEL_H
+
+#include "orbit.h"
+
+enum TrailKernel
+{
+    TRAIL_KERNEL_SCALAR,
+    TRAIL_KERNEL_SSE2,
+    TRAIL_KERNEL_AVX2,
+    TRAIL_KERNEL_NEON
+};
+
+// Active kernel, the widest one supported by the CPU is picked on first use
+TrailKernel GetTrailKernel();
+void SetTrailKernel(TrailKernel kernel);
+bool IsTrailKernelSupported(TrailKernel kernel);
+const char* GetTrailKernelName(TrailKernel kernel);
+
+// Positions of all orbs at count offsets from the anchor (seconds, positive values sample the past).
+// Output is structure-of-arrays: coordinate of orb i at sample j is written to x[i * stride + j].
+void SampleOrbPositionsSoA(
+        const OrbitAnchor& anchor,
+        const float* offsets,
+        int count,
+        float radius,
+        float* x,
+        float* y,
+        float* z,
+        int stride
+);
+
+#endif
@@ -0,0 +1,71 @@
+#include "transform.h"
+#include "raymath.h"
+
+#include <cmath>
+
+// 3x3 part of a raylib Matrix as a flat array, in field order
+static void GetRotationElements(const Matrix& m, float* e)
+{
+    e[0] = m.m0; e[1] = m.m1; e[2] = m.m2;
+    e[3] = m.m4; e[4] = m.m5; e[5] = m.m6;
+    e[6] = m.m8; e[7] = m.m9; e[8] = m.m10;
+}
+
+void ComposePrismRotations(float spin, float hour, Matrix* prisms)
+{
+    static float prismCos[PRISMS];
+    static float prismSin[PRISMS];
+    static bool init = false;
+
+    if (!init)
+    {
+        for (int i = 0; i < PRISMS; i++)
+        {
+            prismCos[i] = cosf(-30.f * i * DEG2RAD);
+            prismSin[i] = sinf(-30.f * i * DEG2RAD);
+        }
+        init = true;
+    }
+
+    // Prism i is Ry(4 * spin), then Rz(angle i), then Ry(-spin) and Rz(hour).
+    // Rz(angle) = cos * P + sin * Q + E is linear in cos/sin, so every prism is a
+    // weighted sum of three matrices shared by the whole frame.
+    Matrix first = MatrixRotateY(4.f * spin);
+    Matrix last  = MatrixMultiplyRotation(MatrixRotateY(-spin), MatrixRotateZ(hour));
+
+    Matrix P = { 0 };
+    Matrix Q = { 0 };
+    Matrix E = { 0 };
+    P.m0  = 1.f; P.m5 = 1.f;
+    Q.m1  = 1.f; Q.m4 = -1.f;
+    E.m10 = 1.f;
+
+    float c[9], s[9], k[9];
+    GetRotationElements(MatrixMultiplyRotation(first, MatrixMultiplyRotation(P, last)), c);
+    GetRotationElements(MatrixMultiplyRotation(first, MatrixMultiplyRotation(Q, last)), s);
+    GetRotationElements(MatrixMultiplyRotation(first, MatrixMultiplyRotation(E, last)), k);
+
+    // One element of all prisms per pass, the inner loop vectorizes
+    float elements[9][PRISMS];
+    for (int e = 0; e < 9; e++)
+        for (int i = 0; i < PRISMS; i++)
+            elements[e][i] = prismCos[i] * c[e] + prismSin[i] * s[e] + k[e];
+
+    for (int i = 0; i < PRISMS; i++)
+    {
+        Matrix& m = prisms[i];
+        m = MatrixIdentity();
+        m.m0 = elements[0][i]; m.m1 = elements[1][i]; m.m2  = elements[2][i];
+        m.m4 = elements[3][i]; m.m5 = elements[4][i]; m.m6  = elements[5][i];
+        m.m8 = elements[6][i]; m.m9 = elements[7][i]; m.m10 = elements[8][i];
+    }
+}
+
+void UpdateFrameTransforms(FrameTransforms* transforms, const OrbitAnchor& anchor, float spin, float hour)
+{
+    ComposePrismRotations(spin, hour, transforms->prisms);
+
+    transforms->orbit = SampleOrbitRotation(anchor, 0.f);
+    for (int i = 0; i < ORBS; i++)
+        transforms->orbs[i] = GetOrbPosition(anchor.secondsInMinute, 1.f, i, transforms->orbit);
+}
@@ -0,0 +1,23 @@
+#ifndef TRANSFORM_H
+#define TRANSFORM_H
+
+#include "raylib.h"
+#include "orbit.h"
+#include "prisms.h"
+
+// Every clock transform is a pure rotation. Rotations are orthonormal, so their inverse
+// is the transpose and their normal matrix (inverse transpose) is the rotation itself.
+
+// Transforms of one frame, composed once in Update and shared by every consumer
+typedef struct
+{
+    Matrix prisms[PRISMS]; // Model and normal matrix of each prism
+    Matrix orbit;          // Orbit rotation at the frame time
+    Vector3 orbs[ORBS];    // Orb positions on a unit-radius orbit
+} FrameTransforms;
+
+// Prism i is rotated by -30 * i degrees around the rod axis, spin and hour angles are in radians
+void ComposePrismRotations(float spin, float hour, Matrix* prisms);
+void UpdateFrameTransforms(FrameTransforms* transforms, const OrbitAnchor& anchor, float spin, float hour);
+
+#endif
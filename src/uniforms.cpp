@@ -0,0 +1,93 @@
+#include "uniforms.h"
+
+#include <cstring>
+
+static UniformStats stats = { 0, 0 };
+
+UniformFloat GetUniformFloat(Shader shader, const char* name)
+{
+    UniformFloat uniform = { shader, GetShaderLocation(shader, name), 0.f, false };
+    return uniform;
+}
+
+UniformVec2 GetUniformVec2(Shader shader, const char* name)
+{
+    UniformVec2 uniform = { shader, GetShaderLocation(shader, name), { 0.f, 0.f }, false };
+    return uniform;
+}
+
+UniformVec3 GetUniformVec3(Shader shader, const char* name)
+{
+    UniformVec3 uniform = { shader, GetShaderLocation(shader, name), { 0.f, 0.f, 0.f }, false };
+    return uniform;
+}
+
+UniformMatrix GetUniformMatrix(Shader shader, const char* name)
+{
+    UniformMatrix uniform = { 0 };
+    uniform.shader   = shader;
+    uniform.location = GetShaderLocation(shader, name);
+    return uniform;
+}
+
+// Shadow values are compared bitwise, the driver would store exactly these bits
+template<typename T>
+static bool IsUniformChanged(bool uploaded, const T& current, const T& value)
+{
+    bool changed = !uploaded || memcmp(&current, &value, sizeof(T)) != 0;
+    CountUniformUpload(changed);
+    return changed;
+}
+
+void SetUniform(UniformFloat* uniform, float value)
+{
+    if (!IsUniformChanged(uniform->uploaded, uniform->value, value))
+        return;
+
+    SetShaderValue(uniform->shader, uniform->location, &value, SHADER_UNIFORM_FLOAT);
+    uniform->value    = value;
+    uniform->uploaded = true;
+}
+
+void SetUniform(UniformVec2* uniform, Vector2 value)
+{
+    if (!IsUniformChanged(uniform->uploaded, uniform->value, value))
+        return;
+
+    SetShaderValue(uniform->shader, uniform->location, &value, SHADER_UNIFORM_VEC2);
+    uniform->value    = value;
+    uniform->uploaded = true;
+}
+
+void SetUniform(UniformVec3* uniform, Vector3 value)
+{
+    if (!IsUniformChanged(uniform->uploaded, uniform->value, value))
+        return;
+
+    SetShaderValue(uniform->shader, uniform->location, &value, SHADER_UNIFORM_VEC3);
+    uniform->value    = value;
+    uniform->uploaded = true;
+}
+
+void SetUniform(UniformMatrix* uniform, const Matrix& value)
+{
+    if (!IsUniformChanged(uniform->uploaded, uniform->value, value))
+        return;
+
+    SetShaderValueMatrix(uniform->shader, uniform->location, value);
+    uniform->value    = value;
+    uniform->uploaded = true;
+}
+
+void CountUniformUpload(bool issued)
+{
+    if (issued)
+        stats.issued++;
+    else
+        stats.skipped++;
+}
+
+UniformStats GetUniformStats()
+{
+    return stats;
+}
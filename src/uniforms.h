@@ -0,0 +1,62 @@
+#ifndef UNIFORMS_H
+#define UNIFORMS_H
+
+#include "raylib.h"
+
+// Shader uniform handles, locations are looked up once at load time.
+// Each handle type only accepts values of its GLSL type and keeps a shadow copy
+// of the last uploaded value, setting the same value again skips the upload.
+typedef struct
+{
+    Shader shader;
+    int location; // -1 when the uniform is missing or optimized out
+    float value;
+    bool uploaded;
+} UniformFloat;
+
+typedef struct
+{
+    Shader shader;
+    int location;
+    Vector2 value;
+    bool uploaded;
+} UniformVec2;
+
+typedef struct
+{
+    Shader shader;
+    int location;
+    Vector3 value;
+    bool uploaded;
+} UniformVec3;
+
+typedef struct
+{
+    Shader shader;
+    int location;
+    Matrix value;
+    bool uploaded;
+} UniformMatrix;
+
+// Uploads sent to the driver versus skipped because the value was unchanged
+typedef struct
+{
+    unsigned long long issued;
+    unsigned long long skipped;
+} UniformStats;
+
+UniformFloat GetUniformFloat(Shader shader, const char* name);
+UniformVec2 GetUniformVec2(Shader shader, const char* name);
+UniformVec3 GetUniformVec3(Shader shader, const char* name);
+UniformMatrix GetUniformMatrix(Shader shader, const char* name);
+
+void SetUniform(UniformFloat* uniform, float value);
+void SetUniform(UniformVec2* uniform, Vector2 value);
+void SetUniform(UniformVec3* uniform, Vector3 value);
+void SetUniform(UniformMatrix* uniform, const Matrix& value);
+
+// Counts uploads of values that are not backed by a handle (e.g. uniform blocks)
+void CountUniformUpload(bool issued);
+UniformStats GetUniformStats();
+
+#endif
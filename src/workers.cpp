@@ -0,0 +1,117 @@
+#include "workers.h"
+
+#if !defined(PLATFORM_WEB)
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+    #include <vector>
+#endif
+
+#if defined(PLATFORM_WEB)
+// No threads without SharedArrayBuffer, batches run inline on dispatch
+void InitWorkers(int count) {}
+void CloseWorkers() {}
+
+void DispatchWorkers(WorkerTask task, void* data, int count)
+{
+    for (int i = 0; i < count; i++)
+        task(data, i);
+}
+
+void WaitWorkers() {}
+#else
+static std::vector<std::thread> workers;
+static std::mutex mutex;
+static std::condition_variable wake;
+static std::condition_variable done;
+
+static WorkerTask batchTask = nullptr;
+static void* batchData      = nullptr;
+static int batchNext        = 0; // Next task index to hand out
+static int batchCount       = 0;
+static int batchPending     = 0; // Tasks not finished yet
+static bool stopping        = false;
+
+// Takes one task of the current batch and runs it, the lock is held on entry and exit
+static void RunTask(std::unique_lock<std::mutex>& lock)
+{
+    WorkerTask task = batchTask;
+    void* data      = batchData;
+    int index       = batchNext++;
+
+    lock.unlock();
+    task(data, index);
+    lock.lock();
+
+    if (--batchPending == 0)
+        done.notify_all();
+}
+
+static void WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+        wake.wait(lock, [] { return stopping || batchNext < batchCount; });
+        if (stopping)
+            return;
+
+        RunTask(lock);
+    }
+}
+
+void InitWorkers(int count)
+{
+    if (!workers.empty())
+        return;
+
+    if (count <= 0)
+        count = (int)std::thread::hardware_concurrency() - 1;
+
+    stopping = false;
+    for (int i = 0; i < count; i++)
+        workers.push_back(std::thread(WorkerLoop));
+}
+
+void CloseWorkers()
+{
+    WaitWorkers();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+
+    workers.clear();
+}
+
+void DispatchWorkers(WorkerTask task, void* data, int count)
+{
+    WaitWorkers();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        batchTask    = task;
+        batchData    = data;
+        batchNext    = 0;
+        batchCount   = count;
+        batchPending = count;
+    }
+
+    if (workers.empty())
+        WaitWorkers();
+    else
+        wake.notify_all();
+}
+
+void WaitWorkers()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (batchNext < batchCount)
+        RunTask(lock);
+
+    done.wait(lock, [] { return batchPending == 0; });
+}
+#endif
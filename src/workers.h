@@ -0,0 +1,16 @@
+#ifndef WORKERS_H
+#define WORKERS_H
+
+// Runs task(data, index) for index 0..count-1
+typedef void (*WorkerTask)(void* data, int index);
+
+// Small fixed pool for per-frame work. Count 0 uses one thread less than the
+// number of cores, the render thread joins in while it waits.
+void InitWorkers(int count);
+void CloseWorkers();
+
+// Queues count tasks and returns immediately, one batch may be in flight at a time
+void DispatchWorkers(WorkerTask task, void* data, int count);
+void WaitWorkers();
+
+#endif
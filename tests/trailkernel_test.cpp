@@ -0,0 +1,81 @@
+// Checks every trail kernel the CPU supports against the scalar orbit math in orbit.cpp.
+// Exits with a non-zero status when any sample is further than TOLERANCE from SampleOrbPosition.
+
+#include "../src/orbit.h"
+#include "../src/trailkernel.h"
+#include "raymath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace std;
+
+const float RADIUS = 6.0f;
+
+// Kernels step from orb to orb by angle addition instead of evaluating sin/cos per orb,
+// which adds a few float ulps per step. 1e-4 of the radius is far below one pixel.
+const float TOLERANCE = 1e-4f * RADIUS;
+
+// Not a multiple of any vector width and longer than one kernel chunk, so tails and chunking are covered
+const int SAMPLES = 203;
+
+const OrbitAnchor ANCHORS[] = {
+    { 0.0f,   0,  0.0f    },
+    { 12.5f,  7,  1.3f    },
+    { 59.99f, 59, -2.9f   },
+    { 30.0f,  30, PI      },
+    { 0.25f,  1,  5.5f    }
+};
+
+static float CheckKernel(TrailKernel kernel, const OrbitAnchor& anchor, const vector<float>& offsets)
+{
+    vector<float> x(ORBS * SAMPLES), y(ORBS * SAMPLES), z(ORBS * SAMPLES);
+
+    SetTrailKernel(kernel);
+    SampleOrbPositionsSoA(anchor, offsets.data(), SAMPLES, RADIUS, x.data(), y.data(), z.data(), SAMPLES);
+
+    float maxError = 0.f;
+    for (int i = 0; i < ORBS; i++)
+    {
+        for (int j = 0; j < SAMPLES; j++)
+        {
+            Vector3 expected = SampleOrbPosition(anchor, offsets[j], RADIUS, i);
+            Vector3 actual   = { x[i * SAMPLES + j], y[i * SAMPLES + j], z[i * SAMPLES + j] };
+            maxError = fmaxf(maxError, Vector3Distance(expected, actual));
+        }
+    }
+
+    return maxError;
+}
+
+int main()
+{
+    // Past samples up to a minute and a half back, crossing minute rollovers of the X rotation
+    vector<float> offsets(SAMPLES);
+    for (int j = 0; j < SAMPLES; j++)
+        offsets[j] = j * 90.f / SAMPLES;
+
+    const TrailKernel kernels[] = { TRAIL_KERNEL_SCALAR, TRAIL_KERNEL_SSE2, TRAIL_KERNEL_AVX2, TRAIL_KERNEL_NEON };
+
+    int failures = 0;
+    for (TrailKernel kernel : kernels)
+    {
+        if (!IsTrailKernelSupported(kernel))
+        {
+            printf("%-6s skipped, not supported\n", GetTrailKernelName(kernel));
+            continue;
+        }
+
+        float maxError = 0.f;
+        for (const OrbitAnchor& anchor : ANCHORS)
+            maxError = fmaxf(maxError, CheckKernel(kernel, anchor, offsets));
+
+        bool passed = maxError <= TOLERANCE;
+        failures += passed ? 0 : 1;
+
+        printf("%-6s max error %g (tolerance %g) %s\n", GetTrailKernelName(kernel), maxError, TOLERANCE, passed ? "ok" : "FAILED");
+    }
+
+    return failures == 0 ? 0 : 1;
+}